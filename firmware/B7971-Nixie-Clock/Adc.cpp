@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Adc.cpp
+ * @summary     Interrupt driven ADC sampler for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include "Adc.h"
+
+// Conversions are triggered by Timer0 compare match A (~977Hz) and
+// alternate channels, so each channel is sampled at ~488Hz
+const uint8_t ADC_LIGHT_BLOCK = 4;      // 16 samples per block
+const uint8_t ADC_LIGHT_RING = 5;       // 32 blocks - about 1 second
+const uint8_t ADC_BATTERY_BLOCK = 6;    // 64 samples per block
+const uint8_t ADC_BATTERY_RING = 4;     // 16 blocks - about 2 seconds
+
+struct AdcChannelStruct
+{
+    uint16_t*   ring;           // Block sums
+    uint8_t     ring_bits;      // log2 ring entries
+    uint8_t     block_bits;     // log2 samples per block
+    uint8_t     mux;
+    uint8_t     ring_index;
+    uint8_t     block_count;
+    bool        primed;         // Ring filled by first block
+    uint16_t    block_sum;
+    uint32_t    block_square;
+    uint16_t    block_min;
+    uint16_t    block_max;
+    uint32_t    ring_sum;       // Running sum of ring entries
+    uint32_t    samples;
+    uint16_t    last_sum;       // Completed block for noise figures
+    uint32_t    last_square;
+    uint16_t    last_peak;
+};
+
+static uint16_t s_ring_light[1 << ADC_LIGHT_RING];
+static uint16_t s_ring_battery[1 << ADC_BATTERY_RING];
+static AdcChannelStruct s_channel[ADC_CHANNELS];
+static volatile uint8_t s_active = 0;
+static uint32_t s_rate_stamp[ADC_CHANNELS]; // millis() at last rate measurement
+static uint32_t s_rate_samples[ADC_CHANNELS]; // Conversions at last rate measurement
+
+
+static void ResetChannel(AdcChannelStruct& channel, uint16_t* ring, const uint8_t ring_bits,
+                         const uint8_t block_bits, const uint8_t mux)
+{
+    memset(&channel, 0, sizeof(channel));
+    channel.ring = ring;
+    channel.ring_bits = ring_bits;
+    channel.block_bits = block_bits;
+    channel.mux = mux;
+    channel.block_min = UINT16_MAX;
+}
+
+
+static uint16_t SquareRoot(uint32_t value)
+{
+    uint32_t result = 0;
+    uint32_t bit = (1UL << 30);
+
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+
+    while (bit)
+    {
+        if (value >= (result + bit))
+        {
+            value -= (result + bit);
+            result = (result >> 1) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+
+        bit >>= 2;
+    }
+
+    return result;
+}
+
+
+void AdcInitialize(void)
+{
+    ResetChannel(s_channel[getValue(AdcChannel::LIGHT)], s_ring_light,
+                 ADC_LIGHT_RING, ADC_LIGHT_BLOCK, (ANALOG_PIN_PHOTODIODE - A0));
+    ResetChannel(s_channel[getValue(AdcChannel::BATTERY)], s_ring_battery,
+                 ADC_BATTERY_RING, ADC_BATTERY_BLOCK, (ANALOG_PIN_BATTERY - A0));
+    s_active = 0;
+
+    for (uint8_t index = 0; index < ADC_CHANNELS; index++)
+    {
+        s_rate_stamp[index] = millis();
+        s_rate_samples[index] = 0;
+    }
+
+    DIDR0 |= (_BV(ANALOG_PIN_PHOTODIODE - A0) | _BV(ANALOG_PIN_BATTERY - A0)); // No digital input buffer
+    ADMUX = (_BV(REFS0) | s_channel[s_active].mux); // AVcc reference
+    ADCSRB = (_BV(ADTS1) | _BV(ADTS0)); // Timer0 compare match A
+    ADCSRA = (_BV(ADEN) | _BV(ADATE) | _BV(ADIE) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0)); // 125kHz
+}
+
+
+// Filtered reading over the whole ring in ADC LSB
+uint16_t GetAdcValue(const AdcChannel channel)
+{
+    const AdcChannelStruct& source = s_channel[getValue(channel)];
+    uint32_t sum;
+
+    cli();
+    sum = source.ring_sum;
+    sei();
+
+    return (sum >> (source.ring_bits + source.block_bits));
+}
+
+
+// False until the first block has filled the ring
+bool AdcIsPrimed(const AdcChannel channel)
+{
+    return s_channel[getValue(channel)].primed;
+}
+
+
+void GetAdcStatistics(const AdcChannel channel, AdcStatisticsStruct& statistics)
+{
+    const AdcChannelStruct& source = s_channel[getValue(channel)];
+    uint32_t samples;
+    uint32_t square;
+    uint16_t sum;
+
+    cli();
+    samples = source.samples;
+    sum = source.last_sum;
+    square = source.last_square;
+    statistics.peak = source.last_peak;
+    sei();
+
+    // Rate over the window since the previous call
+    uint32_t now = millis();
+    uint32_t elapsed = (now - s_rate_stamp[getValue(channel)]);
+    uint32_t window = (samples - s_rate_samples[getValue(channel)]);
+    uint8_t bits = source.block_bits;
+
+    if (elapsed)
+    {
+        statistics.rate = (((uint64_t)window * 1000) / elapsed);
+        s_rate_stamp[getValue(channel)] = now;
+        s_rate_samples[getValue(channel)] = samples;
+    }
+    else
+    {
+        statistics.rate = 0;
+    }
+
+    // Variance = (n * sum(x^2) - sum(x)^2) / n^2, scaled by 256 for 1/16 LSB
+    uint64_t variance = ((((uint64_t)square << bits) - ((uint64_t)sum * sum)) << 8) >> (2 * bits);
+
+    statistics.samples = samples;
+    statistics.value = GetAdcValue(channel);
+    statistics.noise = SquareRoot(variance);
+}
+
+
+ISR(ADC_vect)
+{
+    AdcChannelStruct& channel = s_channel[s_active];
+    uint16_t sample = ADC;
+
+    // Next trigger converts the other channel
+    s_active ^= 1;
+    ADMUX = (_BV(REFS0) | s_channel[s_active].mux);
+
+    channel.samples++;
+    channel.block_sum += sample;
+    channel.block_square += ((uint32_t)sample * sample);
+
+    if (sample < channel.block_min)
+    {
+        channel.block_min = sample;
+    }
+
+    if (sample > channel.block_max)
+    {
+        channel.block_max = sample;
+    }
+
+    if (++channel.block_count < (1 << channel.block_bits))
+    {
+        return;
+    }
+
+    uint8_t entries = (1 << channel.ring_bits);
+
+    if (!channel.primed)
+    {
+        // First block stands in for the whole history
+        for (uint8_t index = 0; index < entries; index++)
+        {
+            channel.ring[index] = channel.block_sum;
+        }
+
+        channel.ring_sum = ((uint32_t)channel.block_sum << channel.ring_bits);
+        channel.primed = true;
+    }
+    else
+    {
+        channel.ring_sum += channel.block_sum;
+        channel.ring_sum -= channel.ring[channel.ring_index];
+        channel.ring[channel.ring_index] = channel.block_sum;
+    }
+
+    channel.ring_index = ((channel.ring_index + 1) & (entries - 1));
+    channel.last_sum = channel.block_sum;
+    channel.last_square = channel.block_square;
+    channel.last_peak = (channel.block_max - channel.block_min);
+    channel.block_count = 0;
+    channel.block_sum = 0;
+    channel.block_square = 0;
+    channel.block_min = UINT16_MAX;
+    channel.block_max = 0;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Adc.h
+ * @summary     Interrupt driven ADC sampler for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _ADC_H
+#define _ADC_H
+
+#include "B7971-Nixie-Clock.h"
+
+enum class AdcChannel : uint8_t
+{
+    LIGHT,      // Photodiode (A3)
+    BATTERY,    // Backup cell (A2)
+};
+
+const uint8_t ADC_CHANNELS = 2;
+
+struct AdcStatisticsStruct
+{
+    AdcStatisticsStruct()
+    : samples(0)
+    , rate(0)
+    , value(0)
+    , noise(0)
+    , peak(0)
+    {
+        // empty
+    }
+
+    uint32_t samples;   // Conversions since initialization
+    uint16_t rate;      // Conversions per second since the previous call
+    uint16_t value;     // Filtered reading in ADC LSB
+    uint16_t noise;     // RMS of last block in 1/16 LSB
+    uint16_t peak;      // Peak-to-peak of last block in ADC LSB
+};
+
+void AdcInitialize(void);
+uint16_t GetAdcValue(const AdcChannel channel);
+bool AdcIsPrimed(const AdcChannel channel);
+void GetAdcStatistics(const AdcChannel channel, AdcStatisticsStruct& statistics);
+
+#endif
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Animation.cpp
+ * @summary     Cooperative display animations for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include "Animation.h"
+
+extern CDisplay g_display;          // class
+
+const uint16_t SLOT_MACHINE_PERIOD = 20; // Milliseconds per spin
+
+static AnimationStepStruct s_queue[ANIMATION_QUEUE];
+static uint8_t s_head = 0; // Running step
+static uint8_t s_length = 0; // Steps queued including the running one
+static uint8_t s_frame = 0; // Frames of running step shown
+static uint16_t s_previous = 0; // millis() of last frame
+static bool s_due = false; // Next frame is shown without waiting
+static char s_target[DISPLAY_COUNT]; // Slot machine final content
+
+
+static AnimationStepStruct* Enqueue(void)
+{
+    if (s_length >= ANIMATION_QUEUE)
+    {
+        return nullptr; // Dropped - callers queue at most a few steps per effect
+    }
+
+    AnimationStepStruct* step = &s_queue[(s_head + s_length) % ANIMATION_QUEUE];
+    *step = AnimationStepStruct();
+
+    if (!s_length)
+    {
+        s_frame = 0;
+        s_due = true;
+    }
+
+    s_length++;
+    return step;
+}
+
+
+static char TextAt(const AnimationStepStruct& step, const uint8_t index)
+{
+    return step.progmem ? pgm_read_byte(&step.text[index]) : step.text[index];
+}
+
+
+// Show frame number s_frame of step - returns false once all frames are shown
+static bool ShowFrame(const AnimationStepStruct& step)
+{
+    char s[DISPLAY_COUNT + 1];
+
+    if (s_frame >= step.count)
+    {
+        return false;
+    }
+
+    for (uint8_t unit = 0; unit < DISPLAY_COUNT; unit++)
+    {
+        s[unit] = g_display.GetUnitValue(unit);
+    }
+
+    s[DISPLAY_COUNT] = '\0';
+
+    switch (step.type)
+    {
+    case AnimationType::SCROLL:
+        if (step.direction == CDisplay::Direction::LEFT)
+        {
+            memmove(&s[0], &s[1], DISPLAY_COUNT - 1);
+            s[DISPLAY_COUNT - 1] = TextAt(step, s_frame);
+        }
+        else
+        {
+            memmove(&s[1], &s[0], DISPLAY_COUNT - 1);
+            s[0] = TextAt(step, step.count - s_frame - 1);
+        }
+        break;
+
+    case AnimationType::SLOT_MACHINE:
+        if (s_frame == 0)
+        {
+            memcpy(s_target, s, DISPLAY_COUNT);
+        }
+
+        for (uint8_t unit = 0; unit < DISPLAY_COUNT; unit++)
+        {
+            // Units settle from left to right, last frame restores content
+            bool spinning = ((s_frame + 1) < step.count)
+                          && (s_frame < (step.count - (DISPLAY_COUNT - unit)));
+            s[unit] = spinning ? ('0' + ((s_target[unit] + s_frame) % 10)) : s_target[unit];
+        }
+        break;
+
+    case AnimationType::HOLD:
+    default:
+        s_frame++;
+        return true;
+    }
+
+    g_display.SetDisplayValue(s);
+    s_frame++;
+    return true;
+}
+
+
+void AnimationScroll(const char* s, const CDisplay::Direction direction, const uint16_t period)
+{
+    AnimationStepStruct* step = Enqueue();
+
+    if (step)
+    {
+        step->type = AnimationType::SCROLL;
+        step->direction = direction;
+        step->period = period;
+        strncpy(step->buffer, s, DISPLAY_COUNT);
+        step->text = step->buffer;
+        step->count = strlen(step->buffer);
+    }
+}
+
+
+void AnimationScroll(const __FlashStringHelper* s, const CDisplay::Direction direction, const uint16_t period)
+{
+    AnimationStepStruct* step = Enqueue();
+
+    if (step)
+    {
+        step->type = AnimationType::SCROLL;
+        step->direction = direction;
+        step->period = period;
+        step->progmem = true;
+        step->text = reinterpret_cast<const char*>(s);
+        step->count = strlen_P(step->text);
+    }
+}
+
+
+void AnimationSlotMachine(const uint8_t cycles)
+{
+    AnimationStepStruct* step = Enqueue();
+
+    if (step)
+    {
+        step->type = AnimationType::SLOT_MACHINE;
+        step->period = SLOT_MACHINE_PERIOD;
+        step->count = cycles;
+    }
+}
+
+
+void AnimationHold(const uint16_t period)
+{
+    AnimationStepStruct* step = Enqueue();
+
+    if (step)
+    {
+        step->type = AnimationType::HOLD;
+        step->period = period;
+        step->count = 1;
+    }
+}
+
+
+// Show every frame that has come due - returns milliseconds until
+// the next frame, or ANIMATION_IDLE when nothing is queued
+uint16_t AnimationUpdate(void)
+{
+    while (s_length)
+    {
+        const AnimationStepStruct& step = s_queue[s_head];
+        uint16_t now = millis();
+        uint16_t elapsed = (now - s_previous);
+
+        if (!s_due && (elapsed < step.period))
+        {
+            return (step.period - elapsed);
+        }
+
+        if (ShowFrame(step))
+        {
+            // Late frames are not caught up - keep the period between frames
+            s_previous = (!s_due && (elapsed < (2 * step.period))) ? (s_previous + step.period) : now;
+            s_due = false;
+            continue;
+        }
+
+        // Step complete - next step starts immediately
+        s_head = ((s_head + 1) % ANIMATION_QUEUE);
+        s_length--;
+        s_frame = 0;
+        s_due = true;
+    }
+
+    return ANIMATION_IDLE;
+}
+
+
+// Abandon queued steps, leaving the display as last shown
+void AnimationCancel(void)
+{
+    s_length = 0;
+    s_frame = 0;
+}
+
+
+bool AnimationIsActive(void)
+{
+    return (s_length != 0);
+}
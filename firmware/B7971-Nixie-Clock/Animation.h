@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Animation.h
+ * @summary     Cooperative display animations for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _ANIMATION_H
+#define _ANIMATION_H
+
+#include "B7971-Nixie-Clock.h"
+
+const uint8_t ANIMATION_QUEUE = 4; // Steps queued behind the running one
+const uint16_t ANIMATION_IDLE = UINT16_MAX;
+
+enum class AnimationType : uint8_t
+{
+    SCROLL,         // Shift text through the display one character per period
+    SLOT_MACHINE,   // Spin digits, settling left to right on the current content
+    HOLD,           // Keep the current content for one period
+};
+
+struct AnimationStepStruct
+{
+    AnimationStepStruct()
+    : type(AnimationType::HOLD)
+    , direction(CDisplay::Direction::LEFT)
+    , progmem(false)
+    , period(0)
+    , count(0)
+    , text(nullptr)
+    , buffer()
+    {
+        // empty
+    }
+
+    AnimationType       type;
+    CDisplay::Direction direction;
+    bool                progmem;    // text is in flash
+    uint16_t            period;     // Milliseconds per frame
+    uint8_t             count;      // Frames
+    const char*         text;
+    char                buffer[DISPLAY_COUNT + 1]; // Copy of RAM text
+};
+
+void AnimationScroll(const char* s, const CDisplay::Direction direction, const uint16_t period);
+void AnimationScroll(const __FlashStringHelper* s, const CDisplay::Direction direction, const uint16_t period);
+void AnimationSlotMachine(const uint8_t cycles);
+void AnimationHold(const uint16_t period);
+uint16_t AnimationUpdate(void);
+void AnimationCancel(void);
+bool AnimationIsActive(void);
+
+#endif
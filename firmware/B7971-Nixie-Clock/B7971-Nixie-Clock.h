@@ -31,11 +31,11 @@
 #include <avr/pgmspace.h>
 #include <avr/eeprom.h>
 #include <avr/wdt.h>
+#include <avr/sleep.h>
 #include <nCoder.h>
-#include <DS323x.h>
 #include <nDisplay.h>
 #include <nAudio.h>
-#include <nI2C.h>
+#include "DS3232.h"
 #include "Music.h"
 
 #ifdef USE_FASTLED
@@ -45,14 +45,23 @@
 
 const uint8_t VERSION       = 5;
 const uint8_t DISPLAY_COUNT = 6;
-const char CONFIG_KEY       = '$';
-const uint8_t ALARM_COUNT   = 3;
+const char CONFIG_KEY       = '$'; // Leads the original unversioned config layout
+const uint8_t ALARM_MAX     = 16;
 
 // Macros to simplify port manipulation without additional overhead
 #define getPort(pin)    ((pin < 8) ? PORTD : ((pin < A0) ? PORTB : PORTC))
+#define getInput(pin)   ((pin < 8) ? PIND : ((pin < A0) ? PINB : PINC))
 #define getMask(pin)    _BV((pin < 8) ? pin : ((pin < A0) ? pin - 8 : pin - A0))
 #define setPinHigh(pin) (getPort(pin) |= getMask(pin))
 #define setPinLow(pin)  (getPort(pin) &= ~getMask(pin))
+#define isPinHigh(pin)  (getInput(pin) & getMask(pin))
+
+// Markers observed by the AVR simulator benchmark (firmware/bench)
+#ifdef BENCH_MARKERS
+#define benchMarker(marker) (GPIOR2 = (marker)) // GPIOR0 holds supervisor check-ins
+#else
+#define benchMarker(marker)
+#endif
 
 /* === Digit Representation ===
 
@@ -147,6 +156,7 @@ enum digital_pin_t : uint8_t
     DIGITAL_PIN_TRANSDUCER_0 = 5,
     DIGITAL_PIN_TRANSDUCER_1 = 6,
     DIGITAL_PIN_TRANSDUCER_2 = 7,
+    DIGITAL_PIN_RTC_SQW = A1, // DS3232 INT/SQW - open drain
 };
 
 enum analog_pin_t : uint8_t
@@ -161,10 +171,21 @@ enum battery_t : uint16_t
     BATTERY_MAX = 3100,
 };
 
+// Timer2 ticks per BCM time unit, minus one
 enum interrupt_speed_t : uint8_t
 {
-    INTERRUPT_FAST = 32, // 16MHz / (60Hz * 8 levels * 1024 prescaler)
-    INTERRUPT_SLOW = 255,
+    INTERRUPT_FAST = 3, // 16MHz / (62Hz * 63 units * 1024 prescaler) - 1
+    INTERRUPT_SLOW = 255, // Fixed period for every bit-plane
+};
+
+const uint16_t TICK_TIMEOUT = 2000; // milliseconds without SQW before polling RTC
+const uint16_t TICK_POLL = 50; // milliseconds between RTC polls without SQW
+const uint16_t DAY_MINUTES = 1440;
+const uint16_t WEEK_MINUTES = (7 * DAY_MINUTES);
+
+enum bench_marker_t : uint8_t
+{
+    BENCH_MARKER_LOOP = 1,
 };
 
 enum class FormatDate : uint8_t
@@ -198,6 +219,7 @@ enum class Effect : uint8_t
     SPIRAL,
     DATE,
     PHRASE,
+    TEMPERATURE,
 };
 
 enum class State : bool
@@ -212,6 +234,7 @@ struct StateStruct
     : voltage(State::DISABLE)
     , display(State::DISABLE)
     , alarm(State::DISABLE)
+    , tick(State::DISABLE)
     {
         // empty
     }
@@ -219,32 +242,70 @@ struct StateStruct
     State voltage;
     State display;
     State alarm;
+    State tick;     // 1Hz SQW on INT/SQW, otherwise Alarm 2 interrupt
 };
 
+// Same 4 byte layout in RAM and in the stored config
 struct AlarmStruct
 {
     AlarmStruct()
-    : state(State::DISABLE)
-    , music(0)
+    : time(0)
     , days(0)
-    , time(0)
+    , music(0)
     {
         // empty
     }
-    
-    State       state;
+
+    uint16_t    time;       // Minutes since midnight, ALARM_ENABLE
+    uint8_t     days;       // Bit 0 = Sunday
     uint8_t     music;
-    uint8_t     days;
-    uint32_t    time;
+} __attribute__((packed));
+
+const uint16_t ALARM_ENABLE = 0x8000;
+const uint16_t ALARM_MINUTE = 0x07FF;
+
+// Next alarm instant, recomputed only when invalidated
+struct AlarmScheduleStruct
+{
+    AlarmScheduleStruct()
+    : valid(false)
+    , index(ALARM_MAX)
+    , minute(0)
+    , count(0)
+    {
+        // empty
+    }
+
+    bool        valid;
+    uint8_t     index;      // ALARM_MAX if no alarm is enabled
+    uint16_t    minute;     // Minutes since Sunday midnight
+    uint8_t     count;      // Enabled alarms in order
+    uint8_t     order[ALARM_MAX]; // Enabled alarm indices sorted by time of day
+};
+
+// Next event programmed into DS3232 Alarm 2
+struct EventScheduleStruct
+{
+    EventScheduleStruct()
+    : minute(0)
+    , alarm(false)
+    , blank(false)
+    , display(State::ENABLE)
+    {
+        // empty
+    }
+
+    uint16_t    minute;     // Minutes since Sunday midnight
+    bool        alarm;      // Play g_alarm_schedule.index
+    bool        blank;      // Blanking edge to display state
+    State       display;
 };
 
 struct Config
 {
     Config()
-    : validate(CONFIG_KEY)
-    , noise(State::ENABLE)
+    : noise(State::ENABLE)
     , battery(State::ENABLE)
-    , alarm_state(0x00)
     , brightness(CDisplay::Brightness::AUTO)
     , gain(10)
     , offset(10)
@@ -255,16 +316,14 @@ struct Config
     , blank_begin(0)
     , blank_end(0)
     , music_timer(0)
+    , alarm_count(0)
     , alarm() // Default initialization
     {
         memcpy_P(phrase, PSTR("Photon"), DISPLAY_COUNT + 1);
     }
 
-    char                    validate;
     State                   noise;
     State                   battery;
-    State                   detonate;
-    uint8_t                 alarm_state;
     CDisplay::Brightness    brightness;
     uint8_t                 gain;
     uint8_t                 offset;
@@ -274,9 +333,9 @@ struct Config
     Effect                  effect;
     uint32_t                blank_begin;
     uint32_t                blank_end;
-    uint8_t                 music_alarm;
     uint8_t                 music_timer;
-    AlarmStruct             alarm[ALARM_COUNT];
+    uint8_t                 alarm_count;
+    AlarmStruct             alarm[ALARM_MAX];
     char                    phrase[DISPLAY_COUNT + 1];
 };
 
@@ -299,7 +358,6 @@ template<typename T> constexpr uint8_t getValue(const T e)
 // strlen_P         CDisplay
 // strncpy          CDisplay
 // strcpy_P         CDisplay
-// snprintf_P       B7971
 // memcpy           B7971
 // memset           B7971
 // memcpy_P         B7971
@@ -309,25 +367,42 @@ template<typename T> constexpr uint8_t getValue(const T e)
 //---------------------------------------------------------------------
 
 // Mode functions
-void Timer(const uint8_t hour, const uint8_t minute, const uint8_t second);
 void Detonate(void);
 void PlayAlarm(const uint8_t song_index, const char* phrase);
 
+// Tick functions
+void RTCSquareWave(State state);
+bool IsSecondTick(void);
+bool IsSecondPoll(void);
+bool UpdateRTC(CRTC::RTC& rtc);
+void WakeCallback(void);
+void WaitEvent(const uint16_t timeout);
+
 // Automatic functions
 void AutoBrightness(void);
-void AutoBlanking(void);
-void AutoAlarm(void);
+void AutoEvent(const CRTC::RTC& rtc);
 
 // Update functions
 void UpdateAlarmIndicator(void);
 
+// Alarm functions
+uint16_t GetWeekMinute(const CRTC::RTC& rtc);
+void SortAlarms(void);
+void UpdateAlarmSchedule(const CRTC::RTC& rtc);
+
+// Event functions
+void ScheduleEvent(void);
+void ProcessEvent(void);
+
 // Format functions
 uint8_t FormatHour(const uint8_t hour);
 void FormatRTCString(const CRTC::RTC& rtc, char* s, const RTCSelect type);
 uint32_t GetSeconds(const uint8_t hour, const uint8_t minute, const uint8_t second);
 
 // Analog functions
+uint32_t ReadLightAverage(void);
 CDisplay::Brightness ReadLightIntensity(void);
+uint8_t ReadLightLevel(void);
 uint32_t ReadBatteryMillivolts(void);
 
 // EEPROM functions
@@ -27,6 +27,20 @@
 
 #include "B7971-Nixie-Clock.h"
 #include "Menu.h"
+#include "Frame.h"
+#include "Adc.h"
+#include "Journal.h"
+#include "Config.h"
+#include "Timer.h"
+#include "Animation.h"
+#include "Input.h"
+#include "Format.h"
+#include "Diagnostics.h"
+#include "Uart.h"
+#include "Protocol.h"
+#include "Discipline.h"
+#include "Supervisor.h"
+#include "Trace.h"
  
 //---------------------------------------------------------------------
 // Global Variables
@@ -42,10 +56,17 @@ CNcoder         g_encoder{DIGITAL_PIN_BUTTON, CNcoder::ButtonMode::NORMAL, CNcod
 
 // Container variables
 CRTC::RTC*      g_rtc_struct;
+AlarmScheduleStruct g_alarm_schedule;
+EventScheduleStruct g_event_schedule;
 
 // Integral variables
-uint8_t         g_encoder_timeout = 0;
 uint8_t         g_song_entries = INBUILT_SONG_COUNT;
+volatile uint8_t g_interrupt_speed = INTERRUPT_FAST;
+volatile bool   g_second_tick = false;
+volatile bool   g_second_wired = false; // INT/SQW edge seen - A1 is not connected on the original board
+volatile bool   g_wake_event = false;
+volatile uint16_t g_second_stamp = 0; // millis() at the last SQW falling edge
+int16_t         g_temperature = 0; // Q8.2 Celsius from background sample
 
 //---------------------------------------------------------------------
 // Functions
@@ -54,19 +75,11 @@ uint8_t         g_song_entries = INBUILT_SONG_COUNT;
 void loop(void)
 {
     CRTC::RTC rtc; // struct
-    uint8_t previous_second;
     char s[DISPLAY_COUNT + 1];
     
     g_rtc_struct = &rtc; // Assign global pointer
     
     GetConfig(g_config);
-
-    if (g_config.validate != CONFIG_KEY)
-    {
-        Config new_config; // Use default constructor values
-        SetConfig(new_config); // Write to EEPROM
-        GetConfig(g_config); // Read from EEPROM
-    }
     
     // Initialize Display
     g_display.SetCallbackIsIncrement(IsInputIncrement);
@@ -75,204 +88,205 @@ void loop(void)
     g_display.SetDisplayBrightness(g_config.brightness);
     InterruptSpeed(INTERRUPT_FAST);
     delay(1); // Wait for interrupt to occur
-    DisplayState(State::ENABLE); // Enable voltage after update
     
     // Initialize RTC
     g_rtc.Initialize();
-    UpdateAlarmIndicator();
+    DisciplineInitialize();
+    DisplayState(State::ENABLE); // Enable voltage after update - selects 1Hz tick
+    ScheduleEvent();
+    g_rtc.RequestTemperature();
+    TraceInitialize(); // After the clock is running - may format the SRAM
     
     // Initialize Encoder
     g_encoder.SetCallback(EncoderCallback); // Register callback function
 
     while (true)
     {
+        benchMarker(BENCH_MARKER_LOOP);
+        SupervisorCheckIn(SupervisorTask::LOOP);
+        SupervisorArm(SupervisorTask::RTC, (g_state.tick == State::ENABLE)); // Alarm 2 wakes may be minutes apart
+        diagnosticsLoopBegin();
+        ProtocolLoopBegin();
         AutoBrightness();
-        previous_second = rtc.second;
-        g_rtc.GetRTC(rtc);
         
-        if (rtc.second != previous_second)
+        g_rtc.ReadTemperature(g_temperature); // Completes in background
+
+        if (UpdateRTC(rtc))
         {
-            switch (rtc.second)
+            DisciplineTick(rtc); // Phase against the serial reference
+            AutoEvent(rtc);
+
+            if (rtc.second == 50)
             {
-            case 15:
-            case 45:
+                g_rtc.RequestTemperature(); // Fresh before the effect at 0 seconds
+            }
+
+            // Clock face waits while an animation owns the display
+            if (!AnimationIsActive())
             {
-                uint8_t word_count = (sizeof(word_array) / sizeof(char*));
-                uint8_t sentence_count = (sizeof(sentence_array) / sizeof(char*));
-                uint8_t max = word_count + sentence_count;
+                switch (rtc.second)
+                {
+                case 15:
+                case 45:
+                {
+                    uint8_t word_count = (sizeof(word_array) / sizeof(char*));
+                    uint8_t sentence_count = (sizeof(sentence_array) / sizeof(char*));
+                    uint8_t max = word_count + sentence_count;
                 
-                #ifdef USE_FASTLED
-                    uint8_t index = random8(max); // FastLED implementation
-                #else
-                    uint8_t index = random(max); // Arduino implementation
-                #endif
+                    #ifdef USE_FASTLED
+                        uint8_t index = random8(max); // FastLED implementation
+                    #else
+                        uint8_t index = random(max); // Arduino implementation
+                    #endif
                 
-                if (index < word_count)
-                {
-                    // Copy item table to local variable
-                    char* array[word_count];
-                    memcpy_P(array, word_array, sizeof(array));
+                    if (index < word_count)
+                    {
+                        // Copy item table to local variable
+                        char* array[word_count];
+                        memcpy_P(array, word_array, sizeof(array));
                     
-                    g_display.SetDisplayValue(reinterpret_cast<const __FlashStringHelper*>(array[index]));
-                    g_display.EffectSlotMachine(44);
-                    delay(3000);
-                }
-                else
-                {
-                    // Copy item table to local variable
-                    char* array[sentence_count];
-                    memcpy_P(array, sentence_array, sizeof(array));
+                        g_display.SetDisplayValue(reinterpret_cast<const __FlashStringHelper*>(array[index]));
+                        AnimationSlotMachine(44);
+                        AnimationHold(3000);
+                    }
+                    else
+                    {
+                        // Copy item table to local variable
+                        char* array[sentence_count];
+                        memcpy_P(array, sentence_array, sizeof(array));
                     
-                    g_display.EffectScroll(F("      "), CDisplay::Direction::LEFT, 150);
-                    g_display.EffectScroll(reinterpret_cast<const __FlashStringHelper*>(array[index - word_count]), CDisplay::Direction::LEFT, 150);
-                    g_display.EffectScroll(F("      "), CDisplay::Direction::LEFT, 150);
-                }
+                        AnimationScroll(F("      "), CDisplay::Direction::LEFT, 150);
+                        AnimationScroll(reinterpret_cast<const __FlashStringHelper*>(array[index - word_count]), CDisplay::Direction::LEFT, 150);
+                        AnimationScroll(F("      "), CDisplay::Direction::LEFT, 150);
+                    }
                 
-                break;
-            }
-            case 0:
-                AutoBlanking();
-                AutoAlarm(); // Do after AutoBlanking - Alarm will enable display
-
-                if (g_config.effect == Effect::SPIRAL)
-                {
-                    g_display.SetDisplayIndicator(false);
-                    g_display.EffectScroll(F("\x18\x19\x1A\x1B\x1C\x1D\x1E\x1F"
-                                             "\x18\x19\x1A\x1B\x1C\x1D\x1E\x1F"
-                                             "\x18\x19\x1A\x1B\x1C\x1D\x1E\x1F"
-                                             "\x18\x19\x1A\x1B\x1C\x1D\x1E\x1F"),
-                                             CDisplay::Direction::LEFT, 54);
-                    g_rtc.GetRTC(rtc); // Refresh RTC
-                    rtc.second++;
-                    FormatRTCString(rtc, s, RTCSelect::TIME);
-                    g_display.EffectScroll(s, CDisplay::Direction::LEFT, 54);
                     break;
                 }
-                [[gnu::fallthrough]]; // Fall-through
-            case 30:
-                if (rtc.second && ((g_config.effect == Effect::DATE) || (g_config.effect == Effect::PHRASE)))
-                {
-                    if (g_config.effect == Effect::PHRASE)
+                case 0:
+                    if (g_config.effect == Effect::SPIRAL)
                     {
-                        // Display phrase
-                        g_display.SetDisplayValue(g_config.phrase);
+                        g_display.SetDisplayIndicator(false);
+                        AnimationScroll(F("\x18\x19\x1A\x1B\x1C\x1D\x1E\x1F"
+                                          "\x18\x19\x1A\x1B\x1C\x1D\x1E\x1F"
+                                          "\x18\x19\x1A\x1B\x1C\x1D\x1E\x1F"
+                                          "\x18\x19\x1A\x1B\x1C\x1D\x1E\x1F"),
+                                        CDisplay::Direction::LEFT, 54);
+                        CRTC::RTC next = rtc;
+                        next.second += 2; // Time when the scroll completes
+                        FormatRTCString(next, s, RTCSelect::TIME);
+                        AnimationScroll(s, CDisplay::Direction::LEFT, 54);
+                        break;
                     }
-                    else
+                    [[gnu::fallthrough]]; // Fall-through
+                case 30:
+                    if (rtc.second && ((g_config.effect == Effect::DATE) || (g_config.effect == Effect::PHRASE)
+                                       || (g_config.effect == Effect::TEMPERATURE)))
                     {
-                        // Display date
-                        FormatRTCString(rtc, s, RTCSelect::DATE);
-                        g_display.SetDisplayValue(s);
+                        if (g_config.effect == Effect::PHRASE)
+                        {
+                            // Display phrase
+                            g_display.SetDisplayValue(g_config.phrase);
+                        }
+                        else if (g_config.effect == Effect::TEMPERATURE)
+                        {
+                            // Display last sampled temperature
+                            FormatTemperature(s, g_temperature, g_config.temperature_unit);
+                            g_display.SetDisplayValue(s);
+                        }
+                        else
+                        {
+                            // Display date
+                            FormatRTCString(rtc, s, RTCSelect::DATE);
+                            g_display.SetDisplayValue(s);
+                        }
+
+                        g_display.SetDisplayIndicator(false);
+                        g_display.SetUnitIndicator(2, (g_config.effect == Effect::TEMPERATURE)); // Decimal point
+                        AnimationSlotMachine(20);
+                        AnimationHold(3050);
+                        break;
                     }
-
-                    g_display.SetDisplayIndicator(false);
-                    g_display.EffectSlotMachine(20);
-                    delay(3050);
-                    break;
-                }
-                [[gnu::fallthrough]]; // Fall-through
-            default:
-                // Show indicators for AM/PM and alarm
-                bool pip = (!rtc.am && (g_config.time_format == FormatTime::H12));
-                g_display.SetUnitIndicator(0, getValue(g_state.alarm)); // Alarm
-                g_display.SetUnitIndicator(5, pip); // AM/PM
+                    [[gnu::fallthrough]]; // Fall-through
+                default:
+                    // Show indicators for AM/PM and alarm
+                    bool pip = (!rtc.am && (g_config.time_format == FormatTime::H12));
+                    g_display.SetUnitIndicator(0, getValue(g_state.alarm)); // Alarm
+                    g_display.SetUnitIndicator(2, false); // Temperature decimal point
+                    g_display.SetUnitIndicator(3, TimerIsActive()); // Countdown or stopwatch
+                    g_display.SetUnitIndicator(5, pip); // AM/PM
                 
-                if ((g_config.battery == State::ENABLE) && !GetBatteryState() && (rtc.second % 2)) // Check battery voltage
-                {
-                    snprintf(s, DISPLAY_COUNT + 1, "Battry");
-                }
-                else
-                {
-                    FormatRTCString(rtc, s, RTCSelect::TIME);
-                }
-                
-                g_display.SetDisplayValue(s);
-                break;
-            }
-        }
-
-        if (IsInputUpdate() || IsInputSelect())
-        {
-            // Check if time threshold elapsed
-            if (g_encoder_timeout == 0)
-            {
-                // Check if display is disabled
-                if (g_state.display == State::DISABLE)
-                {
-                    DisplayState(State::ENABLE);
-                }
-                else
-                {
-                    g_display.SetDisplayIndicator(false);
-                    
-                    // Check if button was pressed
-                    if (IsInputSelect())
-                    {                        
-                        FormatRTCString(rtc, s, RTCSelect::DATE);
-                        g_display.SetDisplayValue(s);
-                        MenuInfo();
+                    if ((g_config.battery == State::ENABLE) && !GetBatteryState() && (rtc.second % 2)) // Check battery voltage
+                    {
+                        memcpy_P(s, PSTR("Battry"), DISPLAY_COUNT + 1);
                     }
                     else
                     {
-                        MenuSettings();
+                        FormatRTCString(rtc, s, RTCSelect::TIME);
                     }
-
-                    UpdateAlarmIndicator();
+                
+                    g_display.SetDisplayValue(s);
+                    break;
                 }
             }
-            
-            g_encoder_timeout = 5;
         }
 
-        if (g_encoder_timeout)
+        if (TimerAcknowledge())
         {
-            g_encoder_timeout--;
+            TraceRecord(TraceType::ALARM, TRACE_TIMER, g_config.music_timer);
+            PlayAlarm(g_config.music_timer, "Count!");
         }
-        
-        delay(50); // Idle
-    }
-}
 
+        InputEventStruct event;
 
-void Timer(const uint8_t hour, const uint8_t minute, const uint8_t second)
-{
-    uint8_t previous_second;
-    uint32_t countdown = (10000 * (uint32_t)hour)
-                       + (100 * (uint32_t)minute)
-                       + (uint32_t)second;
-
-    CRTC::RTC rtc;
-    g_rtc.GetRTC(rtc);
-    previous_second = rtc.second;
-
-    while (countdown)
-    {
-        if (previous_second != rtc.second)
+        if (InputPop(event))
         {
-            if ((countdown % 100) == 0)
+            AnimationCancel(); // Input preempts effects
+
+            // Check if display is disabled
+            if (g_state.display == State::DISABLE)
+            {
+                DisplayState(State::ENABLE);
+                InputFlush(); // Event only wakes the display
+            }
+            else if ((event.type == InputType::INCREMENT) || (event.type == InputType::DECREMENT)
+                     || (event.type == InputType::PRESS))
             {
-                if ((countdown % 10000) == 0)
+                g_display.SetDisplayIndicator(false);
+                SupervisorArm(SupervisorTask::RTC, false); // Menus do not read the clock
+                SupervisorArm(SupervisorTask::MENU, true);
+
+                if (event.type != InputType::PRESS)
+                {
+                    MenuSettings();
+                }
+                else if (TimerIsActive())
+                {
+                    MenuTimer(); // Hotkey while timing
+                }
+                else
                 {
-                    countdown -= 4000; // Subtract hours
+                    FormatRTCString(rtc, s, RTCSelect::DATE);
+                    g_display.SetDisplayValue(s);
+                    MenuInfo();
                 }
 
-                countdown -= 40; // Subtract minutes
+                SupervisorArm(SupervisorTask::MENU, false);
+                ScheduleEvent(); // Alarms, blanking or clock may have changed
+                UpdateAlarmIndicator();
+                InputFlush(); // Discard input left over from menus
+                diagnosticsLoopDiscard();
+                ProtocolLoopBegin(); // Menu time is not loop time
             }
-
-            countdown--; // Subtract seconds
-            previous_second = rtc.second;
-            g_display.SetDisplayValue(countdown);
-        }
-
-        delay(50);
-        g_rtc.GetRTC(rtc);
-
-        if (IsInputSelect())
-        {
-            return;
         }
+        
+        uint16_t wait = AnimationUpdate();
+        uint16_t step = DisciplineUpdate();
+        wait = (step < wait) ? step : wait;
+        diagnosticsLoopEnd();
+        ProtocolUpdate(); // Requests and telemetry
+        TraceUpdate(); // Events timed by the last clock read
+        WaitEvent((wait < 50) ? wait : 50); // Idle until input, tick or next frame
     }
-
-    PlayAlarm(g_config.music_timer, "Count!");
 }
 
 
@@ -294,6 +308,7 @@ void Detonate(void)
 
     do
     {
+        SupervisorCheckIn(SupervisorTask::LOOP); // Countdown runs for seconds without delay()
         g_display.SetDisplayValue(countdown);
 
         if (++timer >= value)
@@ -323,6 +338,7 @@ void Detonate(void)
                 g_display.SetUnitValue(digit, random(128, 255));
             }
             
+            SupervisorCheckIn(SupervisorTask::LOOP); // Fixed sequence, delay() does not check in
             delay(40);
             g_display.SetDisplayValue(F("ERROR#")); // Restore
         }
@@ -330,9 +346,16 @@ void Detonate(void)
     
     g_display.SetDisplayValue(F("\xFF\xFF\xFF\xFF\xFF\xFF")); // Connect all anodes
     g_audio.Play(CAudio::Functions::PGMStream, music_detonate_end_A, music_detonate_end_B, music_detonate_end_B);
+    SupervisorCheckIn(SupervisorTask::LOOP);
     delay(1000);
     g_display.SetDisplayValue(F("      "));
-    delay(3000);
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        SupervisorCheckIn(SupervisorTask::LOOP);
+        delay(1000);
+    }
+
     g_encoder.SetCallback(EncoderCallback); // Enable callback function
     InterruptSpeed(INTERRUPT_FAST);
     g_display.SetDisplayBrightness(g_config.brightness);
@@ -342,145 +365,454 @@ void Detonate(void)
 void PlayAlarm(const uint8_t song_index, const char* phrase)
 {
     uint8_t elapsed_seconds = 0;
-    bool toggle_state = false;
     bool audio_active = false;
+    CRTC::RTC rtc;
 
+    AnimationCancel();
     DisplayState(State::ENABLE);
     g_display.SetDisplayIndicator(false);
     g_display.SetDisplayBrightness(CDisplay::Brightness::MAX);
     InterruptSpeed(INTERRUPT_SLOW);
+    InputFlush(); // Only input during the alarm stops it
     
     // Alarm for at least 120 seconds until music ends or until user interrupt
     do
     {
+        SupervisorCheckIn(SupervisorTask::LOOP);
+
         if (!audio_active)
         {
             PlayMusic(song_index);
         }
         
-        if (g_rtc.GetTimeSeconds() & 0x1)
+        if (UpdateRTC(rtc))
         {
-            if (toggle_state == true)
+            elapsed_seconds++;
+
+            if (rtc.second & 0x1)
             {
-                toggle_state = false;
-                elapsed_seconds++;
                 g_display.SetDisplayValue(phrase);
             }
-        }
-        else
-        {
-            if (toggle_state == false)
+            else
             {
-                toggle_state = true;
-                elapsed_seconds++;
                 g_display.SetDisplayValue(F("      "));
             }
         }
 
-        delay(50);
+        TraceUpdate();
+        WaitEvent(50);
         audio_active = g_audio.IsActive();
         
-    } while (((elapsed_seconds < 120) || audio_active) &&
-             !(IsInputUpdate() || IsInputSelect()));
+    } while (((elapsed_seconds < 120) || audio_active) && !InputIsPending());
 
+    TraceRecord(TraceType::DISMISS, elapsed_seconds, InputIsPending());
     g_audio.Stop(); // Ensure music is stopped
     
-    g_encoder_timeout = 5; // Prevent encoder interaction
+    InputWaitRelease(); // Stopping press does not open a menu
+    InputFlush();
+    diagnosticsLoopDiscard();
+    ProtocolLoopBegin();
     InterruptSpeed(INTERRUPT_FAST);
     g_display.SetDisplayBrightness(g_config.brightness);
 }
 
 
+// ENABLE routes the 1Hz square wave to INT/SQW, DISABLE leaves only Alarm 2
+void RTCSquareWave(State state)
+{
+    uint8_t control;
+
+    if (!g_second_wired)
+    {
+        state = State::ENABLE; // Alarm 2 cannot wake an unwired board - keep polling
+    }
+
+    if (g_state.tick == state)
+    {
+        return; // Already selected
+    }
+
+    if (g_rtc.ReadRegister(DS3232_REGISTER_CONTROL, &control, 1))
+    {
+        // INTCN clear routes the 1Hz square wave (RS2:RS1 = 0) to INT/SQW
+        control &= ~(_BV(DS3232_CONTROL_INTCN) | _BV(DS3232_CONTROL_RS2) | _BV(DS3232_CONTROL_RS1)
+                     | _BV(DS3232_CONTROL_A1IE));
+        control |= _BV(DS3232_CONTROL_A2IE);
+
+        if (state == State::DISABLE)
+        {
+            control |= _BV(DS3232_CONTROL_INTCN);
+        }
+
+        if (g_rtc.WriteRegister(DS3232_REGISTER_CONTROL, &control, 1))
+        {
+            g_state.tick = state;
+        }
+    }
+}
+
+
+// Returns true once per INT/SQW falling edge
+bool IsSecondTick(void)
+{
+    if (g_second_tick)
+    {
+        g_second_tick = false;
+        return true;
+    }
+
+    return false;
+}
+
+
+// Returns true every TICK_POLL while SQW is missing or not wired
+bool IsSecondPoll(void)
+{
+    static uint16_t quiet = 0; // Alarm 2 only - no edge expected
+    static uint16_t poll = 0;
+    uint16_t now = millis();
+    uint16_t edge;
+
+    cli();
+    edge = g_second_stamp;
+    sei();
+
+    if (g_second_wired)
+    {
+        if (g_state.tick == State::DISABLE)
+        {
+            quiet = now;
+            return false;
+        }
+
+        if (((uint16_t)(now - edge) <= TICK_TIMEOUT) || ((uint16_t)(now - quiet) <= TICK_TIMEOUT))
+        {
+            return false;
+        }
+    }
+
+    if ((uint16_t)(now - poll) < TICK_POLL)
+    {
+        return false;
+    }
+
+    poll = now;
+    return true;
+}
+
+
+// Read RTC after a tick - returns true when a new second is visible
+bool UpdateRTC(CRTC::RTC& rtc)
+{
+    static bool retry = false;
+    static bool tick = false; // Read requested for a tick, not only for the trace
+    static bool valid = false; // rtc holds a previous read
+    CRTC::RTC previous = rtc;
+    bool update = false;
+
+    // Collect before requesting - a new request would discard an unread result
+    if (g_rtc.ReadRTC(rtc))
+    {
+        // Registers not yet updated - Alarm 2 wakes may be minutes apart
+        bool same = (valid && (rtc.second == previous.second) && (rtc.minute == previous.minute)
+                     && (rtc.hour == previous.hour));
+
+        valid = true;
+
+        TraceTick(rtc);
+        retry = (tick && same); // Trace reads within the second are not repeated
+        tick = retry;
+
+        if (!same)
+        {
+            SupervisorCheckIn(SupervisorTask::RTC);
+            update = true;
+        }
+    }
+
+    // Transfer completes in the background and wakes WaitEvent()
+    if (IsSecondTick() || retry)
+    {
+        tick = true;
+        retry = !g_rtc.RequestRTC(WakeCallback);
+    }
+    else if (IsSecondPoll() || TraceIsWaiting())
+    {
+        g_rtc.RequestRTC(WakeCallback); // Polls and queued events are not repeated - coalesces with a read in flight
+    }
+
+    return update;
+}
+
+
+void WakeCallback(void)
+{
+    g_wake_event = true;
+}
+
+
+// Sleep until tick, input or timeout (milliseconds)
+void WaitEvent(const uint16_t timeout)
+{
+    uint16_t start = millis();
+
+    UpdateFrame(); // Compose pending changes before sleeping
+    g_wake_event = false;
+
+    while (!g_second_tick && !g_wake_event && !InputIsPending() && !TimerIsExpired() &&
+           ((uint16_t)(millis() - start) < timeout))
+    {
+        // Timers, TWI and EE_READY halt in power-down - only used while blank and silent
+        // and Alarm 2 is known to reach A1
+        bool power_down = ((g_state.display == State::DISABLE) && (g_state.tick == State::DISABLE)
+                           && !g_audio.IsActive()
+                           && TwiIsIdle() && JournalIsIdle() && TimerIsIdle() && InputIsIdle()
+                           && ProtocolIsIdle() && DisciplineIsIdle() && TraceIsIdle());
+        uint8_t eicra = EICRA;
+
+        if (power_down)
+        {
+            wdt_disable(); // Timer0 cannot feed watchdog
+            EICRA = 0; // Low level on encoder pins wakes from power-down
+            UartSleep(true); // So does a start bit on RXD
+        }
+
+        set_sleep_mode(power_down ? SLEEP_MODE_PWR_DOWN : SLEEP_MODE_IDLE);
+        cli();
+
+        if (!g_second_tick && !g_wake_event)
+        {
+            sleep_enable();
+            sei(); // Sleep executes before any pending interrupt
+            sleep_cpu();
+            sleep_disable();
+        }
+
+        sei();
+
+        if (power_down)
+        {
+            cli();
+            EICRA = eicra; // Restore encoder edge detection
+            EIFR = _BV(INTF0) | _BV(INTF1); // Discard flags raised by mode change
+            UartSleep(false);
+            sei();
+            SupervisorEnable();
+        }
+    }
+}
+
+
 void AutoBrightness(void)
 {
     if (g_config.brightness == CDisplay::Brightness::AUTO)
     {
-        CDisplay::Brightness brightness;
-        brightness = ReadLightIntensity();
-        g_display.SetDisplayBrightness(brightness);
+        // Units at AUTO are dimmed with the ambient duty
+        SetFrameAmbient(ReadLightLevel());
+        g_display.SetDisplayBrightness(CDisplay::Brightness::AUTO);
     }
 }
 
 
-void AutoBlanking(void)
+// Handle a matched Alarm 2 - checked on each new minute, or every wake while blank
+void AutoEvent(const CRTC::RTC& rtc)
 {
-    if (g_config.blank_begin != g_config.blank_end)
+    static uint8_t minute = UINT8_MAX;
+
+    if ((rtc.minute != minute) || (g_state.tick == State::DISABLE))
     {
-        uint32_t seconds = g_rtc.GetTimeSeconds();
+        minute = rtc.minute;
 
-        if (seconds == g_config.blank_end)
+        if (g_rtc.AcknowledgeAlarm())
         {
-            DisplayState(State::ENABLE);
+            ProcessEvent();
+            ScheduleEvent();
         }
-        else if (seconds == g_config.blank_begin)
+    }
+
+    UpdateAlarmIndicator();
+}
+
+
+// Indicate an alarm within the next 24 hours
+void UpdateAlarmIndicator(void)
+{
+    State next_state = State::DISABLE; // Assume disabled
+
+    if (g_alarm_schedule.valid && (g_alarm_schedule.index < ALARM_MAX))
+    {
+        uint16_t minute = GetWeekMinute(*g_rtc_struct);
+        uint16_t distance = (g_alarm_schedule.minute >= minute)
+                          ? (g_alarm_schedule.minute - minute)
+                          : (g_alarm_schedule.minute + WEEK_MINUTES - minute);
+
+        if (distance <= DAY_MINUTES)
         {
-            DisplayState(State::DISABLE);
+            next_state = State::ENABLE;
         }
     }
+
+    // Update alarm indicator
+    g_state.alarm = static_cast<decltype(g_state.alarm)>(next_state);
 }
 
 
-void AutoAlarm(void)
+uint16_t GetWeekMinute(const CRTC::RTC& rtc)
 {
-    uint32_t current_time = GetSeconds(g_rtc_struct->hour, g_rtc_struct->minute, 0);
-    
-    for (uint8_t index = 0; index < ALARM_COUNT; index++)
+    return (((rtc.week_day - 1) * DAY_MINUTES) + (rtc.hour * 60U) + rtc.minute);
+}
+
+
+// Rebuild the time ordered index of enabled alarms - call when alarms change
+void SortAlarms(void)
+{
+    uint8_t count = 0;
+
+    for (uint8_t index = 0; index < g_config.alarm_count; index++)
+    {
+        const AlarmStruct& alarm = g_config.alarm[index];
+
+        if (!(alarm.time & ALARM_ENABLE) || !alarm.days)
+        {
+            continue;
+        }
+
+        uint8_t position = count++;
+
+        // Insertion sort - equal times keep table order
+        while (position && ((g_config.alarm[g_alarm_schedule.order[position - 1]].time & ALARM_MINUTE)
+                            > (alarm.time & ALARM_MINUTE)))
+        {
+            g_alarm_schedule.order[position] = g_alarm_schedule.order[position - 1];
+            position--;
+        }
+
+        g_alarm_schedule.order[position] = index;
+    }
+
+    g_alarm_schedule.count = count;
+}
+
+
+// Find the earliest enabled alarm after the current minute by walking
+// the sorted index forward across midnight and the end of the week
+void UpdateAlarmSchedule(const CRTC::RTC& rtc)
+{
+    uint16_t today = ((rtc.hour * 60U) + rtc.minute);
+    uint8_t position = 0;
+
+    // Skip alarms at or before the current minute today
+    while ((position < g_alarm_schedule.count)
+           && ((g_config.alarm[g_alarm_schedule.order[position]].time & ALARM_MINUTE) <= today))
     {
-        // Check if alarm is enabled
-        if (g_config.alarm[index].state == State::ENABLE)
+        position++;
+    }
+
+    g_alarm_schedule.index = ALARM_MAX;
+    g_alarm_schedule.valid = true;
+
+    // Offset 7 is the same weekday next week, for alarms earlier today
+    for (uint8_t offset = 0; offset <= 7; offset++, position = 0)
+    {
+        uint8_t day = ((rtc.week_day - 1 + offset) % 7); // Sunday = 0
+
+        for (; position < g_alarm_schedule.count; position++)
         {
-            // Check if alarm day matches current day
-            if ((g_config.alarm[index].days >> g_rtc_struct->week_day) & 0x1)
+            uint8_t index = g_alarm_schedule.order[position];
+            const AlarmStruct& alarm = g_config.alarm[index];
+
+            if ((offset == 7) && ((alarm.time & ALARM_MINUTE) > today))
             {
-                // Check if alarm time matches current time
-                if (g_config.alarm[index].time == current_time)
-                {
-                    PlayAlarm(g_config.alarm[index].music, g_config.phrase);
-                    break; // No need to process remaining alarms
-                }
+                return; // Already searched from today
+            }
+
+            if ((alarm.days >> day) & 0x1)
+            {
+                g_alarm_schedule.index = index;
+                g_alarm_schedule.minute = ((day * DAY_MINUTES) + (alarm.time & ALARM_MINUTE));
+                return;
             }
         }
     }
-    
-    UpdateAlarmIndicator();
 }
 
 
-void UpdateAlarmIndicator(void)
+// Program the earliest alarm or blanking edge into Alarm 2
+// Call when alarms, blanking or the clock change
+void ScheduleEvent(void)
 {
     CRTC::RTC rtc;
-    uint8_t day;
-    State next_state = State::DISABLE; // Assume disabled
-    
     g_rtc.GetRTC(rtc);
-    uint32_t current_time = GetSeconds(rtc.hour, rtc.minute, 0);
-    
-    for (uint8_t index = 0; index < ALARM_COUNT; index++)
+    SortAlarms();
+    UpdateAlarmSchedule(rtc);
+
+    uint16_t now = GetWeekMinute(rtc);
+    uint16_t today = ((rtc.hour * 60U) + rtc.minute);
+    uint16_t best = UINT16_MAX;
+
+    g_event_schedule = EventScheduleStruct();
+
+    if (g_alarm_schedule.index < ALARM_MAX)
+    {
+        best = (g_alarm_schedule.minute > now)
+             ? (g_alarm_schedule.minute - now)
+             : (g_alarm_schedule.minute + WEEK_MINUTES - now);
+        g_event_schedule.alarm = true;
+    }
+
+    if (g_config.blank_begin != g_config.blank_end)
     {
-        // Check if alarm is enabled
-        if (g_config.alarm[index].state == State::ENABLE)
+        for (uint8_t edge = 0; edge < 2; edge++)
         {
-            // Determine which day to check
-            if (g_config.alarm[index].time > current_time)
-            {
-                day = rtc.week_day; // Today
-            }
-            else
+            State state = (edge == 0) ? State::DISABLE : State::ENABLE;
+            uint16_t time = (((edge == 0) ? g_config.blank_begin : g_config.blank_end) / 60);
+            uint16_t distance = (time > today) ? (time - today) : (time + DAY_MINUTES - today);
+
+            if (distance < best)
             {
-                day = (rtc.week_day > 6) ? 1 : (rtc.week_day + 1); // Tomorrow
+                best = distance;
+                g_event_schedule.alarm = false;
             }
 
-            // Check if alarm is active for selected day
-            if ((g_config.alarm[index].days >> day) & 0x1)
+            if (distance == best)
             {
-                next_state = State::ENABLE;
-                break; // Alarm will be indicated - no need to continue
+                g_event_schedule.blank = true;
+                g_event_schedule.display = state;
             }
         }
     }
 
-    // Update alarm indicator
-    g_state.alarm = static_cast<decltype(g_state.alarm)>(next_state);
+    if (best == UINT16_MAX)
+    {
+        g_rtc.SetAlarm(0, 0, 0); // Nothing pending
+    }
+    else
+    {
+        uint16_t minute = ((now + best) % WEEK_MINUTES);
+        uint16_t time = (minute % DAY_MINUTES);
+
+        g_event_schedule.minute = minute;
+        g_rtc.SetAlarm((minute / DAY_MINUTES) + 1, (time / 60), (time % 60));
+    }
+
+    g_rtc.AcknowledgeAlarm(); // Discard flag from previous match
+}
+
+
+// Apply the event that matched Alarm 2
+void ProcessEvent(void)
+{
+    if (g_event_schedule.blank)
+    {
+        DisplayState(g_event_schedule.display);
+    }
+
+    // Do after blanking - Alarm will enable display
+    if (g_event_schedule.alarm && (g_alarm_schedule.index < ALARM_MAX))
+    {
+        TraceRecord(TraceType::ALARM, g_alarm_schedule.index, g_config.alarm[g_alarm_schedule.index].music);
+        PlayAlarm(g_config.alarm[g_alarm_schedule.index].music, g_config.phrase);
+    }
 }
 
 
@@ -501,12 +833,10 @@ uint8_t FormatHour(const uint8_t hour)
 
 void FormatRTCString(const CRTC::RTC& rtc, char* s, const RTCSelect type)
 {
-    const char* format_string = PSTR("%02u%02u%02u");
-
     switch (type)
     {
     case RTCSelect::TIME:
-        snprintf_P(s, DISPLAY_COUNT + 1, format_string, FormatHour(rtc.hour), rtc.minute, rtc.second);
+        FormatFields(s, FormatHour(rtc.hour), rtc.minute, rtc.second);
         break;
 
     case RTCSelect::DATE:
@@ -514,15 +844,15 @@ void FormatRTCString(const CRTC::RTC& rtc, char* s, const RTCSelect type)
         {
         default:
         case FormatDate::YYMMDD:
-            snprintf_P(s, DISPLAY_COUNT + 1, format_string, rtc.year, rtc.month, rtc.day);
+            FormatFields(s, rtc.year, rtc.month, rtc.day);
             break;
 
         case FormatDate::MMDDYY:
-            snprintf_P(s, DISPLAY_COUNT + 1, format_string, rtc.month, rtc.day, rtc.year);
+            FormatFields(s, rtc.month, rtc.day, rtc.year);
             break;
 
         case FormatDate::DDMMYY:
-            snprintf_P(s, DISPLAY_COUNT + 1, format_string, rtc.day, rtc.month, rtc.year);
+            FormatFields(s, rtc.day, rtc.month, rtc.year);
             break;
         }
 
@@ -537,24 +867,22 @@ uint32_t GetSeconds(const uint8_t hour, const uint8_t minute, const uint8_t seco
 }
 
 
+uint32_t ReadLightAverage(void)
+{
+    uint32_t average = (GetAdcValue(AdcChannel::LIGHT) + g_config.offset);
+    average *= g_config.gain;
+    average /= 10; // pseudo float
+    return average;
+}
+
+
 CDisplay::Brightness ReadLightIntensity(void)
 {
-    const uint8_t SAMPLES = 32;
-    static uint16_t history[SAMPLES];
     static uint8_t result = 0;
     static uint32_t previous_average = 0;
-    uint32_t average = 0;
+    uint32_t average = ReadLightAverage();
     int32_t difference;
 
-    for (uint8_t index = 0; index < (SAMPLES - 1); index++)
-    {
-        average += (history[index] = history[index + 1]);
-    }
-
-    average += (history[SAMPLES - 1] = (analogRead(ANALOG_PIN_PHOTODIODE - A0) + g_config.offset));
-    average /= SAMPLES;
-    average *= g_config.gain;
-    average /= 10; // pseudo float
     difference = (average - previous_average);
     difference = (difference > 0) ? difference : -difference;
 
@@ -586,35 +914,71 @@ CDisplay::Brightness ReadLightIntensity(void)
 }
 
 
-uint32_t ReadBatteryMillivolts(void)
+// Returns BCM duty (8-63) tracking ambient light
+uint8_t ReadLightLevel(void)
 {
-    const uint8_t samples = 16;
-    static uint16_t history[samples] = {510u, 510u, 510u, 510u,
-                                        510u, 510u, 510u, 510u,
-                                        510u, 510u, 510u, 510u,
-                                        510u, 510u, 510u, 510u};
-    uint8_t index;
-    uint32_t average = 0;
+    static uint8_t target = FRAME_DUTY_MAX;
+    static uint8_t level = FRAME_DUTY_MAX;
+    uint32_t average = ReadLightAverage();
+    uint32_t value;
+
+    // Continuous version of ReadLightIntensity() steps (8 duty per step)
+    if (average < 100)
+    {
+        value = 8 + ((average * 24) / 100);
+    }
+    else
+    {
+        value = 32 + (((average - 100) * 32) / 500);
+    }
 
-    for (index = 0; index < (samples - 1); index++)
+    if (value > FRAME_DUTY_MAX)
     {
-        average += (history[index] = history[index+1]);
+        value = FRAME_DUTY_MAX;
     }
 
-    average += (history[samples-1] = analogRead(ANALOG_PIN_BATTERY));
-    average /= samples;
+    // Ignore single step dither except at full brightness
+    int16_t difference = (value - target);
+
+    if ((difference > 1) || (difference < -1) || (value == FRAME_DUTY_MAX))
+    {
+        target = value;
+    }
 
-    return ((average * 49) / 10); // Convert to millivolts
+    // Slew one step per call
+    if (level < target)
+    {
+        level++;
+    }
+    else if (level > target)
+    {
+        level--;
+    }
+
+    return level;
+}
+
+
+uint32_t ReadBatteryMillivolts(void)
+{
+    return ((GetAdcValue(AdcChannel::BATTERY) * 49UL) / 10); // Convert to millivolts
 }
 
 
 bool GetBatteryState(void)
 {
     static uint8_t hysteresis = 0;
+    uint16_t millivolts = ReadBatteryMillivolts();
 
-    if (ReadBatteryMillivolts() < (BATTERY_MIN + hysteresis))
+    if (millivolts < (BATTERY_MIN + hysteresis))
     {
-        hysteresis = 25; // millivolts
+        // Reads zero until the ADC ring is filled
+        if (!hysteresis && AdcIsPrimed(AdcChannel::BATTERY))
+        {
+            TraceRecord(TraceType::BATTERY, (millivolts & 0xFF), (millivolts >> 8));
+            hysteresis = 25; // millivolts
+        }
+
         return false; // voltage low, replace battery
     }
     else
@@ -626,24 +990,6 @@ bool GetBatteryState(void)
 }
 
 
-void GetConfig(Config& config)
-{
-    while (!eeprom_is_ready());
-    cli();
-    eeprom_read_block((void*)&config, (void*)0, sizeof(Config));
-    sei();
-}
-
-
-void SetConfig(const Config& config)
-{
-    while (!eeprom_is_ready());
-    cli();
-    eeprom_update_block((const void*)&config, (void*)0, sizeof(Config));
-    sei();
-}
-
-
 void VoltageState(State state)
 {
     g_state.voltage = state;
@@ -653,22 +999,35 @@ void VoltageState(State state)
 
 void DisplayState(State state)
 {
+    if (g_state.display != state)
+    {
+        TraceRecord(TraceType::BLANK, (state == State::DISABLE), 0);
+    }
+
     g_state.display = state;
     digitalWrite(DIGITAL_PIN_BLANK, getValue(state));
     VoltageState(state);
+    RTCSquareWave(state); // No 1Hz wake while blank
 }
 
 
 void InterruptSpeed(const uint8_t speed)
 {
-    // set compare match register for xHz increments
-    OCR2A = speed; // = (16MHz) / (x*prescale) - 1 (must be <255)
+    // Display ISR programs OCR2A per bit-plane from this time unit
+    #ifdef BENCH_INTERRUPT_SPEED
+        g_interrupt_speed = BENCH_INTERRUPT_SPEED; // Pinned by benchmark image
+    #else
+        g_interrupt_speed = speed;
+    #endif
 }
 
 
 __attribute__((optimize("-O3")))
 void EncoderCallback(void)
 {
+    InputRotate(g_encoder.GetRotation());
+    g_wake_event = true; // Wake main loop
+
     if (g_config.noise == State::ENABLE)
     {
         g_audio.Play(CAudio::Functions::MemStream, music_blip, music_blip, music_blip);
@@ -678,33 +1037,71 @@ void EncoderCallback(void)
 
 bool IsInputIncrement(void)
 {
-    return (g_encoder.GetRotation() == CNcoder::Rotation::CW);
+    return InputIsIncrement(); // Direction of last step
 }
 
 
 bool IsInputSelect(void)
 {
-    return (g_encoder.GetButtonState() == CNcoder::Button::DOWN);
+    return InputSelect(); // Queued press, then held until its RELEASE
 }
 
 
+// Prompts poll here while waiting for input
 bool IsInputUpdate(void)
 {
-    return (g_encoder.IsUpdateAvailable());
+    SupervisorCheckIn(SupervisorTask::LOOP);
+    UpdateFrame();
+    return InputStep(); // Accelerated per InputSetCurve()
+}
+
+
+// Called by delay() while waiting - no check-in, so a stuck wait still starves the watchdog
+void yield(void)
+{
+    UpdateFrame();
 }
 
 
-// Interrupt is called every millisecond
+// Interrupt is called every 1.024 milliseconds
 ISR(TIMER0_COMPA_vect) 
 {
-    wdt_reset(); // Reset watchdog timer
+    diagnosticsIsr(DiagnosticsIsr::TICK);
+    SupervisorTick(); // Feed watchdog while every task checks in
+    TwiTick(); // TWI timeout and retry backoff
+    TimerTick(); // Countdowns and stopwatch
+    InputTick(); // Button gestures
+}
+
+
+// DS3232 1Hz square wave - falling edge starts a new second
+ISR(PCINT1_vect)
+{
+    if (!isPinHigh(DIGITAL_PIN_RTC_SQW))
+    {
+        g_second_stamp = millis();
+        g_second_tick = true;
+        g_second_wired = true;
+    }
 }
 
 
 ISR(TIMER2_COMPA_vect)
 {
-    static uint8_t pwm_cycle = 0;
-    static const uint8_t toggle[] = {0xFF, 0x01, 0x11, 0x25, 0x55, 0x5B, 0x77, 0x7F, 0xFF};
+    diagnosticsIsr(DiagnosticsIsr::DISPLAY);
+    SupervisorCheckIn(SupervisorTask::DISPLAY);
+    static uint8_t plane = 0;
+    uint8_t speed = g_interrupt_speed;
+
+    plane++;
+
+    if (plane >= FRAME_PLANES)
+    {
+        plane = 0;
+    }
+
+    // Hold bit-plane for its binary weight of time units
+    OCR2A = (speed == INTERRUPT_SLOW) ? speed : (((speed + 1) << plane) - 1);
     
     sei(); // Enable interrupts for audio processing
     
@@ -714,40 +1111,26 @@ ISR(TIMER2_COMPA_vect)
         return;
     }
 
-    pwm_cycle++;
+    // Bit-plane is precomposed by UpdateFrame()
+    const uint8_t* frame = GetFramePlane(plane);
 
-    if (pwm_cycle > 7)
-    {
-        pwm_cycle = 0;
-    }
-    
-    // Update at 1/8 speed during audio playback
-    if (g_audio.IsActive() && (pwm_cycle > 0))
+    // Latches already hold this bit-plane
+    if (frame == nullptr)
     {
         return;
     }
 
     setPinLow(DIGITAL_PIN_LATCH); // latch
 
-    for (uint8_t tube = DISPLAY_COUNT - 1; tube < 255; tube--)
+    for (uint8_t index = 0; index < FRAME_BYTES; index++)
     {
-        uint16_t digit_bitmap = 0;
+        uint8_t data = frame[index];
 
-        if ((toggle[getValue(g_display.GetUnitBrightness(tube))] >> pwm_cycle) & 0x1)
-        {
-            uint8_t unit = g_display.GetUnitValue(tube);
-            uint8_t indicator = g_display.GetUnitIndicator(tube);
-        
-            digit_bitmap = (pgm_read_word_near(BITMAP + unit - 24) | (indicator << 1));
-        }
-
-        for (uint16_t index = 0; index < 16; index++)
+        for (uint8_t mask = 0x80; mask; mask >>= 1)
         {
             setPinHigh(DIGITAL_PIN_CLOCK); // clock
 
-            uint8_t segment = ((digit_bitmap >> (15 - index)) & 0x1);
-            
-            if (segment)
+            if (data & mask)
             {
                 setPinHigh(DIGITAL_PIN_SDATA); // sdata
             }
@@ -776,9 +1159,7 @@ void setup(void)
     pinMode(DIGITAL_PIN_TRANSDUCER_0, OUTPUT);  // Transducer A
     pinMode(DIGITAL_PIN_TRANSDUCER_1, OUTPUT);  // Transducer B
     pinMode(DIGITAL_PIN_TRANSDUCER_2, OUTPUT);  // Transducer B
-    
-    // Watchdog timer
-    wdt_enable(WDTO_1S); // Set for 1 second
+    pinMode(DIGITAL_PIN_RTC_SQW, INPUT_PULLUP); // RTC Square Wave
     
     // Millisecond timer
     OCR0A = 0x7D;
@@ -788,8 +1169,24 @@ void setup(void)
     TCCR2A = 0; // Reset register
     TCCR2B = 0; // Reset register
     TCNT2  = 0; // Initialize counter value to 0
-    //OCR2A set by InterruptSpeed() function - 8 bit register
+    //OCR2A set per bit-plane by display ISR - 8 bit register
     TCCR2A |= _BV(WGM21); // Enable CTC mode
     TCCR2B |= (1 << CS22) | (1 << CS21) | (1 << CS20); // Set for 1024 prescaler
     TIMSK2 |= _BV(OCIE2A); // Enable timer compare interrupt
+
+    // Pin change interrupt (RTC tick)
+    PCMSK1 |= _BV(PCINT9); // A1
+    PCICR |= _BV(PCIE1);
+
+    // Config restored from EEPROM journal
+    ConfigInitialize();
+
+    // Watchdog fed only while tasks check in, previous reset logged
+    SupervisorInitialize();
+
+    // Photodiode and battery sampled in background
+    AdcInitialize();
+
+    // Remote control and telemetry on D0/D1
+    UartInitialize();
 }
@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Config.cpp
+ * @summary     Versioned EEPROM config format for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include <util/crc16.h>
+#include "Config.h"
+#include "Journal.h"
+#include "Trace.h"
+
+const uint8_t CONFIG_ALARMS_VERSION1 = 3;
+
+// Layout written before versioning, tagged by CONFIG_KEY in place of a version
+struct ConfigLegacyStruct
+{
+    char        validate;
+    uint8_t     noise;
+    uint8_t     battery;
+    uint8_t     detonate;
+    uint8_t     alarm_state;
+    uint8_t     brightness;
+    uint8_t     gain;
+    uint8_t     offset;
+    uint8_t     date_format;
+    uint8_t     time_format;
+    uint8_t     temperature_unit;
+    uint8_t     effect;
+    uint32_t    blank_begin;    // Seconds since midnight
+    uint32_t    blank_end;
+    uint8_t     music_alarm;
+    uint8_t     music_timer;
+    struct
+    {
+        uint8_t     state;
+        uint8_t     music;
+        uint8_t     days;
+        uint32_t    time;
+    } __attribute__((packed)) alarm[CONFIG_ALARMS_VERSION1];
+    char        phrase[DISPLAY_COUNT + 1];
+} __attribute__((packed));
+
+// Fixed layout with three alarms, days in bits 1-7
+struct ConfigVersion1Struct
+{
+    uint8_t     version;
+    uint8_t     flags;
+    uint8_t     brightness;
+    uint8_t     gain;
+    uint8_t     offset;
+    uint8_t     format;
+    uint8_t     effect;
+    uint8_t     music_timer;
+    uint16_t    blank_begin;
+    uint16_t    blank_end;
+    struct
+    {
+        uint8_t     music;
+        uint8_t     days;
+        uint16_t    time;       // Minutes since midnight, ALARM_ENABLE
+    } __attribute__((packed)) alarm[CONFIG_ALARMS_VERSION1];
+    char        phrase[DISPLAY_COUNT];
+    uint16_t    crc;
+} __attribute__((packed));
+
+static_assert(sizeof(AlarmStruct) == 4, "Alarm record size");
+static_assert(sizeof(ConfigRecordStruct) + sizeof(uint16_t) <= JOURNAL_CONFIG_BYTES, "Config record size");
+static_assert(sizeof(ConfigVersion1Struct) <= JOURNAL_CONFIG_BYTES, "Version 1 config size");
+static_assert(sizeof(ConfigLegacyStruct) <= JOURNAL_CONFIG_BYTES, "Legacy config size");
+
+typedef bool (*ConfigLoader)(const uint8_t* image, Config& config);
+
+struct ConfigMigrationStruct
+{
+    uint8_t         version;
+    ConfigLoader    load;
+};
+
+static bool LoadLegacy(const uint8_t* image, Config& config);
+static bool LoadVersion1(const uint8_t* image, Config& config);
+static bool LoadVersion2(const uint8_t* image, Config& config);
+
+// Every stored version and how it is brought up to Config
+static const ConfigMigrationStruct migration[] PROGMEM =
+{
+    {CONFIG_KEY, LoadLegacy},
+    {1, LoadVersion1},
+    {2, LoadVersion2},
+};
+
+static ConfigStatisticsStruct s_statistics;
+
+
+static uint16_t RecordCRC(const uint8_t* data, const uint8_t length)
+{
+    uint16_t crc = 0xFFFF;
+
+    for (uint8_t index = 0; index < length; index++)
+    {
+        crc = _crc16_update(crc, data[index]);
+    }
+
+    return crc;
+}
+
+
+// Bytes preceding the CRC of a record holding count alarms
+static uint8_t RecordLength(const uint8_t count)
+{
+    return (CONFIG_HEADER_BYTES + (count * sizeof(AlarmStruct)));
+}
+
+
+// Older layouts keep the Sunday to Saturday day mask in bits 1-7
+static void LoadAlarmVersion1(AlarmStruct& alarm, const bool state, const uint8_t music,
+                              const uint8_t days, const uint16_t minutes)
+{
+    alarm.time = (((minutes < DAY_MINUTES) ? minutes : 0) | (state ? ALARM_ENABLE : 0));
+    alarm.days = ((days >> 1) & 0x7F);
+    alarm.music = music;
+}
+
+
+static uint32_t ToSeconds(const uint16_t minutes)
+{
+    return ((minutes < DAY_MINUTES) ? (60UL * minutes) : 0);
+}
+
+
+static uint16_t ToMinutes(const uint32_t seconds)
+{
+    return ((seconds < (60UL * DAY_MINUTES)) ? (seconds / 60) : 0);
+}
+
+
+// Returns stored length - alarms are only appended or deleted from the menu
+static uint8_t PackConfig(const Config& config, uint8_t* image)
+{
+    ConfigRecordStruct record;
+    uint8_t count = (config.alarm_count < ALARM_MAX) ? config.alarm_count : ALARM_MAX;
+
+    record.version = CONFIG_VERSION;
+    record.flags = (((config.noise == State::ENABLE) ? CONFIG_FLAG_NOISE : 0)
+                 | ((config.battery == State::ENABLE) ? CONFIG_FLAG_BATTERY : 0));
+    record.brightness = getValue(config.brightness);
+    record.gain = config.gain;
+    record.offset = config.offset;
+    record.format = ((getValue(config.date_format) & CONFIG_FORMAT_DATE)
+                  | ((config.time_format == FormatTime::H12) ? CONFIG_FORMAT_H12 : 0)
+                  | ((config.temperature_unit == CRTC::Unit::F) ? CONFIG_FORMAT_F : 0));
+    record.effect = getValue(config.effect);
+    record.music_timer = config.music_timer;
+    record.blank_begin = ToMinutes(config.blank_begin);
+    record.blank_end = ToMinutes(config.blank_end);
+    memcpy(record.phrase, config.phrase, DISPLAY_COUNT);
+    record.alarm_count = count;
+    memcpy(record.alarm, config.alarm, count * sizeof(AlarmStruct));
+
+    uint8_t length = RecordLength(count);
+    uint16_t crc = RecordCRC(reinterpret_cast<const uint8_t*>(&record), length);
+    memcpy(image, &record, length);
+    memcpy(&image[length], &crc, sizeof(crc));
+    return (length + sizeof(crc));
+}
+
+
+static bool LoadVersion2(const uint8_t* image, Config& config)
+{
+    ConfigRecordStruct record;
+    uint16_t crc;
+
+    // Header fields only - AlarmStruct constructors leave the alarms initialized
+    memcpy(static_cast<void*>(&record), image, CONFIG_HEADER_BYTES);
+
+    if ((record.version != 2) || (record.alarm_count > ALARM_MAX))
+    {
+        return false;
+    }
+
+    uint8_t length = RecordLength(record.alarm_count);
+    memcpy(&crc, &image[length], sizeof(crc));
+
+    if (crc != RecordCRC(image, length))
+    {
+        return false;
+    }
+
+    config.noise = (record.flags & CONFIG_FLAG_NOISE) ? State::ENABLE : State::DISABLE;
+    config.battery = (record.flags & CONFIG_FLAG_BATTERY) ? State::ENABLE : State::DISABLE;
+    config.brightness = static_cast<CDisplay::Brightness>(record.brightness);
+    config.gain = record.gain;
+    config.offset = record.offset;
+    config.date_format = static_cast<FormatDate>(record.format & CONFIG_FORMAT_DATE);
+    config.time_format = (record.format & CONFIG_FORMAT_H12) ? FormatTime::H12 : FormatTime::H24;
+    config.temperature_unit = (record.format & CONFIG_FORMAT_F) ? CRTC::Unit::F : CRTC::Unit::C;
+    config.effect = static_cast<Effect>(record.effect);
+    config.music_timer = record.music_timer;
+    config.blank_begin = ToSeconds(record.blank_begin);
+    config.blank_end = ToSeconds(record.blank_end);
+    memcpy(config.phrase, record.phrase, DISPLAY_COUNT);
+    config.phrase[DISPLAY_COUNT] = '\0';
+    config.alarm_count = record.alarm_count;
+    memcpy(config.alarm, &image[CONFIG_HEADER_BYTES], record.alarm_count * sizeof(AlarmStruct));
+    return true;
+}
+
+
+
+static bool LoadVersion1(const uint8_t* image, Config& config)
+{
+    ConfigVersion1Struct record;
+    memcpy(&record, image, sizeof(record));
+
+    if ((record.version != 1)
+        || (record.crc != RecordCRC(image, offsetof(ConfigVersion1Struct, crc))))
+    {
+        return false;
+    }
+
+    config.noise = (record.flags & CONFIG_FLAG_NOISE) ? State::ENABLE : State::DISABLE;
+    config.battery = (record.flags & CONFIG_FLAG_BATTERY) ? State::ENABLE : State::DISABLE;
+    config.brightness = static_cast<CDisplay::Brightness>(record.brightness);
+    config.gain = record.gain;
+    config.offset = record.offset;
+    config.date_format = static_cast<FormatDate>(record.format & CONFIG_FORMAT_DATE);
+    config.time_format = (record.format & CONFIG_FORMAT_H12) ? FormatTime::H12 : FormatTime::H24;
+    config.temperature_unit = (record.format & CONFIG_FORMAT_F) ? CRTC::Unit::F : CRTC::Unit::C;
+    config.effect = static_cast<Effect>(record.effect);
+    config.music_timer = record.music_timer;
+    config.blank_begin = ToSeconds(record.blank_begin);
+    config.blank_end = ToSeconds(record.blank_end);
+
+    config.alarm_count = CONFIG_ALARMS_VERSION1;
+
+    for (uint8_t index = 0; index < CONFIG_ALARMS_VERSION1; index++)
+    {
+        LoadAlarmVersion1(config.alarm[index], (record.alarm[index].time & ALARM_ENABLE),
+                          record.alarm[index].music, record.alarm[index].days,
+                          (record.alarm[index].time & ~ALARM_ENABLE));
+    }
+
+    memcpy(config.phrase, record.phrase, DISPLAY_COUNT);
+    config.phrase[DISPLAY_COUNT] = '\0';
+    return true;
+}
+
+
+static bool LoadLegacy(const uint8_t* image, Config& config)
+{
+    ConfigLegacyStruct legacy;
+    memcpy(&legacy, image, sizeof(legacy));
+
+    if (legacy.validate != CONFIG_KEY)
+    {
+        return false;
+    }
+
+    config.noise = static_cast<State>(legacy.noise);
+    config.battery = static_cast<State>(legacy.battery);
+    config.brightness = static_cast<CDisplay::Brightness>(legacy.brightness);
+    config.gain = legacy.gain;
+    config.offset = legacy.offset;
+    config.date_format = static_cast<FormatDate>(legacy.date_format);
+    config.time_format = static_cast<FormatTime>(legacy.time_format);
+    config.temperature_unit = static_cast<CRTC::Unit>(legacy.temperature_unit);
+    config.effect = static_cast<Effect>(legacy.effect);
+    config.music_timer = legacy.music_timer;
+    config.blank_begin = ToSeconds(ToMinutes(legacy.blank_begin));
+    config.blank_end = ToSeconds(ToMinutes(legacy.blank_end));
+
+    config.alarm_count = CONFIG_ALARMS_VERSION1;
+
+    for (uint8_t index = 0; index < CONFIG_ALARMS_VERSION1; index++)
+    {
+        LoadAlarmVersion1(config.alarm[index], (legacy.alarm[index].state != 0),
+                          legacy.alarm[index].music, legacy.alarm[index].days,
+                          ToMinutes(legacy.alarm[index].time));
+    }
+
+    memcpy(config.phrase, legacy.phrase, DISPLAY_COUNT);
+    config.phrase[DISPLAY_COUNT] = '\0';
+    return true;
+}
+
+
+// Returns false if image holds no valid record of a known version
+static bool LoadImage(const uint8_t* image, Config& config)
+{
+    for (uint8_t index = 0; index < (sizeof(migration) / sizeof(migration[0])); index++)
+    {
+        if (pgm_read_byte(&migration[index].version) == image[0])
+        {
+            ConfigLoader load = reinterpret_cast<ConfigLoader>(pgm_read_ptr(&migration[index].load));
+
+            if (load(image, config))
+            {
+                s_statistics.loaded = image[0];
+                s_statistics.migrated = (image[0] != CONFIG_VERSION);
+                return true;
+            }
+
+            config = Config(); // Discard partially loaded fields
+            return false;
+        }
+    }
+
+    return false;
+}
+
+
+// Load stored config, migrating older versions, or fall back to defaults
+void ConfigInitialize(void)
+{
+    uint8_t image[JOURNAL_CONFIG_BYTES];
+    Config config; // Use default constructor values
+
+    JournalInitialize();
+    JournalRead(JOURNAL_CONFIG_OFFSET, image, sizeof(image)); // Erased if the journal is empty
+
+    // Older firmware wrote the record at address 0, where its bytes may pass
+    // as journal records by chance - trust the journal only if it holds a record
+    if (!LoadImage(image, config))
+    {
+        eeprom_read_block((void*)image, (const void*)0, sizeof(image));
+        LoadImage(image, config);
+    }
+
+    SetConfig(config); // Stores current version if anything differs
+}
+
+
+void GetConfigStatistics(ConfigStatisticsStruct& statistics)
+{
+    statistics = s_statistics;
+}
+
+
+void GetConfig(Config& config)
+{
+    uint8_t image[JOURNAL_CONFIG_BYTES];
+    JournalRead(JOURNAL_CONFIG_OFFSET, image, sizeof(image));
+    config = Config();
+    LoadVersion2(image, config);
+}
+
+
+void SetConfig(const Config& config)
+{
+    uint8_t image[JOURNAL_CONFIG_BYTES];
+    const uint8_t brightness = offsetof(ConfigRecordStruct, brightness);
+    uint8_t previous[brightness + 1]; // Stored record up to the brightness
+
+    JournalRead(JOURNAL_CONFIG_OFFSET, previous, sizeof(previous));
+    memset(image, 0xFF, sizeof(image)); // Release chunks beyond the record
+    s_statistics.bytes = PackConfig(config, image);
+
+    if (JournalWrite(JOURNAL_CONFIG_OFFSET, image, sizeof(image)))
+    {
+        if ((previous[0] == CONFIG_VERSION) && (previous[brightness] != image[brightness]))
+        {
+            TraceRecord(TraceType::BRIGHTNESS, image[brightness], previous[brightness]);
+        }
+
+        TraceRecord(TraceType::CONFIG, s_statistics.bytes, CONFIG_VERSION);
+    }
+}
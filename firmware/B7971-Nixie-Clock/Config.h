@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Config.h
+ * @summary     Versioned EEPROM config format for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _CONFIG_H
+#define _CONFIG_H
+
+#include "B7971-Nixie-Clock.h"
+
+const uint8_t CONFIG_VERSION = 2;
+
+// Stored layout, times have minute resolution - fields are never moved, new versions append or migrate
+// Only alarm_count alarms are stored, followed by the CRC-16 of all preceding bytes
+struct ConfigRecordStruct
+{
+    uint8_t     version;
+    uint8_t     flags;          // CONFIG_FLAG_*
+    uint8_t     brightness;
+    uint8_t     gain;
+    uint8_t     offset;
+    uint8_t     format;         // CONFIG_FORMAT_*
+    uint8_t     effect;
+    uint8_t     music_timer;
+    uint16_t    blank_begin;    // Minutes since midnight
+    uint16_t    blank_end;
+    char        phrase[DISPLAY_COUNT];
+    uint8_t     alarm_count;
+    AlarmStruct alarm[ALARM_MAX];
+} __attribute__((packed));
+
+const uint8_t CONFIG_HEADER_BYTES = offsetof(ConfigRecordStruct, alarm);
+
+enum config_flag_t : uint8_t
+{
+    CONFIG_FLAG_NOISE = 0x01,
+    CONFIG_FLAG_BATTERY = 0x02,
+};
+
+enum config_format_t : uint8_t
+{
+    CONFIG_FORMAT_DATE = 0x03,  // FormatDate
+    CONFIG_FORMAT_H12 = 0x04,   // FormatTime::H12
+    CONFIG_FORMAT_F = 0x08,     // CRTC::Unit::F
+};
+
+struct ConfigStatisticsStruct
+{
+    ConfigStatisticsStruct()
+    : loaded(0)
+    , migrated(0)
+    , bytes(0)
+    {
+        // empty
+    }
+
+    uint8_t loaded;     // Version found at boot, 0 if defaults were used
+    bool migrated;      // Converted from an older version
+    uint8_t bytes;      // Size of the last record stored, including CRC
+};
+
+void ConfigInitialize(void);
+void GetConfigStatistics(ConfigStatisticsStruct& statistics);
+
+#endif
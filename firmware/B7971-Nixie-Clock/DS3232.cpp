@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        DS3232.cpp
+ * @summary     DS3232 real-time clock driver for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include "DS3232.h"
+
+const uint8_t DS3232_HOURS_12H = 6;
+const uint8_t DS3232_HOURS_PM = 5;
+
+
+static uint8_t ToBCD(const uint8_t value)
+{
+    return (((value / 10) << 4) | (value % 10));
+}
+
+
+static uint8_t FromBCD(const uint8_t value)
+{
+    return (((value >> 4) * 10) + (value & 0x0F));
+}
+
+
+static uint8_t DecodeHour(const uint8_t value)
+{
+    if (value & _BV(DS3232_HOURS_12H))
+    {
+        return ((FromBCD(value & 0x1F) % 12) + ((value & _BV(DS3232_HOURS_PM)) ? 12 : 0));
+    }
+
+    return FromBCD(value & 0x3F);
+}
+
+
+static void DecodeRTC(const uint8_t* buffer, CRTC::RTC& rtc)
+{
+    rtc.second = FromBCD(buffer[DS3232_REGISTER_SECONDS] & 0x7F);
+    rtc.minute = FromBCD(buffer[DS3232_REGISTER_MINUTES] & 0x7F);
+    rtc.hour = DecodeHour(buffer[DS3232_REGISTER_HOURS]);
+    rtc.week_day = (buffer[DS3232_REGISTER_DAY] & 0x07);
+    rtc.day = FromBCD(buffer[DS3232_REGISTER_DATE] & 0x3F);
+    rtc.month = FromBCD(buffer[DS3232_REGISTER_MONTH] & 0x1F); // Century bit ignored
+    rtc.year = FromBCD(buffer[DS3232_REGISTER_YEAR]);
+    rtc.am = (rtc.hour < 12);
+}
+
+
+// Day of week for 2000-2099 - Sunday = 1
+static uint8_t WeekDay(const uint8_t year, const uint8_t month, const uint8_t day)
+{
+    static const uint8_t offset[] PROGMEM = {0, 3, 2, 5, 0, 3, 5, 1, 4, 6, 2, 4};
+    uint16_t y = (2000 + year) - (month < 3);
+    return (((y + (y / 4) - (y / 100) + (y / 400) + pgm_read_byte(offset + month - 1) + day) % 7) + 1);
+}
+
+
+// Two's complement integer part, 0.25 degree fraction in upper bits
+static int16_t DecodeTemperature(const uint8_t* buffer)
+{
+    return (((int16_t)(int8_t)buffer[0] * DS3232_TEMPERATURE_ONE) + (buffer[1] >> 6));
+}
+
+
+// Integer division rounded half away from zero
+static int16_t DivideRound(const int16_t value, const int16_t divisor)
+{
+    return ((value + ((value < 0) ? -(divisor / 2) : (divisor / 2))) / divisor);
+}
+
+
+int16_t CRTC::ConvertTemperature(const int16_t value, const Unit from, const Unit to)
+{
+    if (from == to)
+    {
+        return value;
+    }
+
+    return (to == Unit::F) ? (DivideRound(value * 9, 5) + (32 * DS3232_TEMPERATURE_ONE))
+                           : DivideRound((value - (32 * DS3232_TEMPERATURE_ONE)) * 5, 9);
+}
+
+
+CDS3232::CDS3232(void)
+: m_request()
+, m_temperature_request()
+{
+    // empty
+}
+
+
+void CDS3232::Initialize(void)
+{
+    TwiInitialize();
+}
+
+
+void CDS3232::GetRTC(RTC& rtc)
+{
+    uint8_t buffer[DS3232_TIME_BYTES];
+
+    if (ReadRegister(DS3232_REGISTER_SECONDS, buffer, sizeof(buffer)))
+    {
+        DecodeRTC(buffer, rtc);
+    }
+}
+
+
+void CDS3232::SetTime(const uint8_t hour, const uint8_t minute, const uint8_t second)
+{
+    uint8_t buffer[] = {ToBCD(second), ToBCD(minute), ToBCD(hour)}; // 24 hour mode
+    WriteRegister(DS3232_REGISTER_SECONDS, buffer, sizeof(buffer));
+}
+
+
+void CDS3232::SetDate(const uint8_t year, const uint8_t month, const uint8_t day)
+{
+    uint8_t buffer[] = {WeekDay(year, month, day), ToBCD(day), ToBCD(month), ToBCD(year)};
+    WriteRegister(DS3232_REGISTER_DAY, buffer, sizeof(buffer));
+}
+
+
+bool CDS3232::ReadRegister(const uint8_t reg, uint8_t* data, const uint8_t length)
+{
+    return TwiRead(TWI_ADDRESS_DS3232, reg, data, length);
+}
+
+
+bool CDS3232::WriteRegister(const uint8_t reg, const uint8_t* data, const uint8_t length)
+{
+    return TwiWrite(TWI_ADDRESS_DS3232, reg, data, length);
+}
+
+
+// Match day of week, hour and minute at second 00
+bool CDS3232::SetAlarm(const uint8_t week_day, const uint8_t hour, const uint8_t minute)
+{
+    uint8_t buffer[] = {ToBCD(minute), ToBCD(hour), (uint8_t)(_BV(DS3232_ALARM_DYDT) | week_day)};
+    return WriteRegister(DS3232_REGISTER_ALARM2, buffer, sizeof(buffer));
+}
+
+
+// Returns true if Alarm 2 matched since last call, clearing its flag
+bool CDS3232::AcknowledgeAlarm(void)
+{
+    uint8_t status;
+
+    if (!ReadRegister(DS3232_REGISTER_STATUS, &status, 1) || !(status & _BV(DS3232_STATUS_A2F)))
+    {
+        return false;
+    }
+
+    status &= ~_BV(DS3232_STATUS_A2F); // Flags ignore writes of one
+    WriteRegister(DS3232_REGISTER_STATUS, &status, 1);
+    return true;
+}
+
+
+// Queue read of time registers - returns true if a read is in flight
+bool CDS3232::RequestRTC(void (*callback)(void))
+{
+    if (m_request.status == TwiStatus::PENDING)
+    {
+        return true; // Coalesce with request in flight
+    }
+
+    m_request.address = TWI_ADDRESS_DS3232;
+    m_request.reg = DS3232_REGISTER_SECONDS;
+    m_request.data = m_buffer;
+    m_request.length = sizeof(m_buffer);
+    m_request.read = true;
+    m_request.callback = callback;
+    return TwiSubmit(m_request);
+}
+
+
+// Returns true once for each completed RequestRTC()
+bool CDS3232::ReadRTC(RTC& rtc)
+{
+    if (m_request.status != TwiStatus::COMPLETE)
+    {
+        return false;
+    }
+
+    DecodeRTC(m_buffer, rtc);
+    m_request.status = TwiStatus::IDLE;
+    return true;
+}
+
+
+// Queue read of temperature registers - returns true if a read is in flight
+bool CDS3232::RequestTemperature(void)
+{
+    if (m_temperature_request.status == TwiStatus::PENDING)
+    {
+        return true;
+    }
+
+    m_temperature_request.address = TWI_ADDRESS_DS3232;
+    m_temperature_request.reg = DS3232_REGISTER_TEMPERATURE;
+    m_temperature_request.data = m_temperature;
+    m_temperature_request.length = sizeof(m_temperature);
+    m_temperature_request.read = true;
+    return TwiSubmit(m_temperature_request);
+}
+
+
+// Returns true once for each completed RequestTemperature()
+bool CDS3232::ReadTemperature(int16_t& temperature)
+{
+    if (m_temperature_request.status != TwiStatus::COMPLETE)
+    {
+        return false;
+    }
+
+    temperature = DecodeTemperature(m_temperature);
+    m_temperature_request.status = TwiStatus::IDLE;
+    return true;
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        DS3232.h
+ * @summary     DS3232 real-time clock driver for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _DS3232_H
+#define _DS3232_H
+
+#include "Twi.h"
+
+enum ds3232_register_t : uint8_t
+{
+    DS3232_REGISTER_SECONDS = 0x00,
+    DS3232_REGISTER_MINUTES = 0x01,
+    DS3232_REGISTER_HOURS = 0x02,
+    DS3232_REGISTER_DAY = 0x03,
+    DS3232_REGISTER_DATE = 0x04,
+    DS3232_REGISTER_MONTH = 0x05,
+    DS3232_REGISTER_YEAR = 0x06,
+    DS3232_REGISTER_ALARM1 = 0x07,
+    DS3232_REGISTER_ALARM2 = 0x0B,
+    DS3232_REGISTER_CONTROL = 0x0E,
+    DS3232_REGISTER_STATUS = 0x0F,
+    DS3232_REGISTER_AGING = 0x10,
+    DS3232_REGISTER_TEMPERATURE = 0x11,
+    DS3232_REGISTER_SRAM = 0x14,
+};
+
+enum ds3232_control_t : uint8_t
+{
+    DS3232_CONTROL_A1IE = 0,
+    DS3232_CONTROL_A2IE = 1,
+    DS3232_CONTROL_INTCN = 2,
+    DS3232_CONTROL_RS1 = 3,
+    DS3232_CONTROL_RS2 = 4,
+    DS3232_CONTROL_CONV = 5,
+    DS3232_CONTROL_BBSQW = 6,
+    DS3232_CONTROL_EOSC = 7,
+};
+
+enum ds3232_status_t : uint8_t
+{
+    DS3232_STATUS_A1F = 0,
+    DS3232_STATUS_A2F = 1,
+    DS3232_STATUS_BSY = 2,
+    DS3232_STATUS_EN32KHZ = 3,
+    DS3232_STATUS_OSF = 7,
+};
+
+enum ds3232_alarm_t : uint8_t
+{
+    DS3232_ALARM_DYDT = 6,  // Day of week instead of date
+    DS3232_ALARM_MASK = 7,  // Field ignored in match
+};
+
+const uint8_t DS3232_TIME_BYTES = (DS3232_REGISTER_YEAR + 1);
+const int16_t DS3232_TEMPERATURE_ONE = 4; // Q8.2 - quarter degrees
+
+class CRTC
+{
+    public:
+
+    enum class Unit : uint8_t
+    {
+        C,
+        F,
+    };
+
+    struct RTC
+    {
+        RTC()
+        : second(0)
+        , minute(0)
+        , hour(0)
+        , week_day(1)
+        , day(1)
+        , month(1)
+        , year(0)
+        , am(true)
+        {
+            // empty
+        }
+
+        uint8_t second;
+        uint8_t minute;
+        uint8_t hour;       // 0-23
+        uint8_t week_day;   // 1-7, Sunday = 1
+        uint8_t day;
+        uint8_t month;
+        uint8_t year;       // 2000-based
+        bool    am;
+    };
+
+    // Temperatures are Q8.2 fixed point in quarter degrees
+    static int16_t ConvertTemperature(const int16_t value, const Unit from, const Unit to);
+};
+
+class CDS3232 : public CRTC
+{
+    public:
+
+    CDS3232(void);
+
+    void Initialize(void);
+
+    // Blocking access - sleeps until the transaction completes
+    void GetRTC(RTC& rtc);
+    void SetTime(const uint8_t hour, const uint8_t minute, const uint8_t second);
+    void SetDate(const uint8_t year, const uint8_t month, const uint8_t day);
+    bool ReadRegister(const uint8_t reg, uint8_t* data, const uint8_t length);
+    bool WriteRegister(const uint8_t reg, const uint8_t* data, const uint8_t length);
+
+    // Alarm 2 - week_day 0 never matches
+    bool SetAlarm(const uint8_t week_day, const uint8_t hour, const uint8_t minute);
+    bool AcknowledgeAlarm(void);
+
+    // Asynchronous time read - callback runs in interrupt context
+    bool RequestRTC(void (*callback)(void));
+    bool ReadRTC(RTC& rtc);
+
+    // Asynchronous temperature read - Celsius, updated by the DS3232 every 64 seconds
+    bool RequestTemperature(void);
+    bool ReadTemperature(int16_t& temperature);
+
+    private:
+
+    TwiTransactionStruct m_request;
+    TwiTransactionStruct m_temperature_request;
+    uint8_t m_buffer[DS3232_TIME_BYTES];
+    uint8_t m_temperature[2];
+};
+
+#endif
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Diagnostics.cpp
+ * @summary     Performance counters for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include "Diagnostics.h"
+
+#ifdef DIAGNOSTICS
+
+#include "Format.h"
+#include "Twi.h"
+#include "Journal.h"
+
+const uint8_t DIAGNOSTICS_PAINT = 0xC5; // Marks stack never reached
+
+static DiagnosticsIsrStruct s_isr[getValue(DiagnosticsIsr::COUNT)];
+static uint16_t s_loop[DIAGNOSTICS_BUCKETS];
+static uint32_t s_longest = 0;
+static uint32_t s_block = 0;
+static uint32_t s_begin = 0; // micros() at start of loop iteration
+static bool s_discard = false;
+
+#ifndef HOST_BUILD
+extern uint8_t _end;    // End of .bss - no heap is used
+extern uint8_t __stack; // Last SRAM address
+
+// Runs before constructors, after the stack pointer is initialized
+__attribute__((naked, used, section(".init3")))
+static void DiagnosticsPaint(void)
+{
+    for (uint8_t* address = &_end; address < (uint8_t*)SP; address++)
+    {
+        *address = DIAGNOSTICS_PAINT;
+    }
+}
+#endif
+
+
+// Called from interrupt context
+CDiagnosticsScope::~CDiagnosticsScope(void)
+{
+    DiagnosticsIsrStruct& isr = s_isr[getValue(m_isr)];
+    uint8_t ticks = (TCNT0 - m_begin); // Handlers are far shorter than a Timer0 period
+
+    isr.count++;
+    isr.ticks += ticks;
+
+    if (ticks > isr.max)
+    {
+        isr.max = ticks;
+    }
+}
+
+
+CDiagnosticsBlock::~CDiagnosticsBlock(void)
+{
+    uint32_t elapsed = (micros() - m_begin);
+
+    if (elapsed > s_block)
+    {
+        s_block = elapsed;
+    }
+}
+
+
+void DiagnosticsLoopBegin(void)
+{
+    s_begin = micros();
+}
+
+
+// Called before the main loop sleeps
+void DiagnosticsLoopEnd(void)
+{
+    uint32_t elapsed = (micros() - s_begin);
+
+    if (s_discard)
+    {
+        s_discard = false; // Iteration waited on the user
+        return;
+    }
+
+    uint8_t bucket = 0;
+
+    for (uint32_t limit = 1000; (elapsed >= limit) && (bucket < (DIAGNOSTICS_BUCKETS - 1)); limit *= 10)
+    {
+        bucket++;
+    }
+
+    if (s_loop[bucket] < UINT16_MAX)
+    {
+        s_loop[bucket]++;
+    }
+
+    if (elapsed > s_longest)
+    {
+        s_longest = elapsed;
+    }
+}
+
+
+// Exclude current iteration - menus and alarms block on input
+void DiagnosticsLoopDiscard(void)
+{
+    s_discard = true;
+}
+
+
+void GetDiagnostics(DiagnosticsStruct& diagnostics)
+{
+    cli();
+    memcpy(diagnostics.isr, s_isr, sizeof(s_isr));
+    sei();
+
+    memcpy(diagnostics.loop, s_loop, sizeof(s_loop));
+    diagnostics.longest = s_longest;
+    diagnostics.block = s_block;
+    diagnostics.stack = 0;
+    diagnostics.free = 0;
+
+    #ifndef HOST_BUILD
+        uint8_t* address = &_end;
+
+        while ((address < (uint8_t*)SP) && (*address == DIAGNOSTICS_PAINT))
+        {
+            address++;
+        }
+
+        diagnostics.stack = (&__stack - address) + 1;
+        diagnostics.free = (SP - (uint16_t)&_end);
+    #endif
+}
+
+
+// MenuInfo page as two character label and four digit value
+void FormatDiagnostics(char* s, const uint8_t page)
+{
+    static const char label[DIAGNOSTICS_PAGES][2] PROGMEM =
+    {
+        {'T', '2'}, {'T', '0'}, {'H', '0'}, {'H', '1'}, {'H', '2'}, {'H', '3'},
+        {'L', 'p'}, {'B', 'k'}, {'S', 't'}, {'F', 'r'}, {'I', '2'}, {'E', 'E'},
+    };
+
+    DiagnosticsStruct diagnostics;
+    TwiStatisticsStruct twi;
+    JournalStatisticsStruct journal;
+    uint32_t value = 0;
+
+    GetDiagnostics(diagnostics);
+    GetTwiStatistics(twi);
+    GetJournalStatistics(journal);
+
+    switch (page)
+    {
+    case 0:
+    case 1:
+        value = (diagnostics.isr[page].max * DIAGNOSTICS_TICK_US); // microseconds
+        break;
+    case 2:
+    case 3:
+    case 4:
+    case 5:
+        value = diagnostics.loop[page - 2];
+        break;
+    case 6:
+        value = (diagnostics.longest / 1000); // milliseconds
+        break;
+    case 7:
+        value = diagnostics.block; // microseconds
+        break;
+    case 8:
+        value = diagnostics.stack;
+        break;
+    case 9:
+        value = diagnostics.free;
+        break;
+    case 10:
+        value = twi.completed;
+        break;
+    case 11:
+        value = journal.records;
+        break;
+    }
+
+    memcpy_P(s, label[page], 2);
+    FormatDecimal(&s[2], (value > 9999) ? 9999 : value, 4, ' ');
+    s[DISPLAY_COUNT] = '\0';
+}
+
+#endif
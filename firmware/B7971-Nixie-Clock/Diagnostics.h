@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Diagnostics.h
+ * @summary     Performance counters for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _DIAGNOSTICS_H
+#define _DIAGNOSTICS_H
+
+#include "B7971-Nixie-Clock.h"
+
+// Build with -DDIAGNOSTICS - production images compile every hook to nothing
+#ifdef DIAGNOSTICS
+
+const uint8_t DIAGNOSTICS_BUCKETS = 4; // Loop time decades from 1 ms
+const uint8_t DIAGNOSTICS_PAGES = (8 + DIAGNOSTICS_BUCKETS);
+const uint8_t DIAGNOSTICS_TICK_US = 4; // Timer0 prescaler of 64
+
+enum class DiagnosticsIsr : uint8_t
+{
+    DISPLAY,    // Timer2 bit-plane refresh
+    TICK,       // Timer0 millisecond tick
+    COUNT,
+};
+
+struct DiagnosticsIsrStruct
+{
+    DiagnosticsIsrStruct()
+    : count(0)
+    , ticks(0)
+    , max(0)
+    {
+        // empty
+    }
+
+    uint32_t count;     // Calls
+    uint32_t ticks;     // Timer0 ticks spent, 64 cycles each
+    uint8_t  max;       // Longest call in ticks
+};
+
+struct DiagnosticsStruct
+{
+    DiagnosticsStruct()
+    : isr()
+    , loop()
+    , longest(0)
+    , block(0)
+    , stack(0)
+    , free(0)
+    {
+        // empty
+    }
+
+    DiagnosticsIsrStruct isr[getValue(DiagnosticsIsr::COUNT)];
+    uint16_t loop[DIAGNOSTICS_BUCKETS]; // Awake loop iterations per decade, saturating
+    uint32_t longest;   // microseconds of longest loop iteration outside menus
+    uint32_t block;     // microseconds of longest synchronous I2C transaction
+    uint16_t stack;     // Peak stack use in bytes
+    uint16_t free;      // SRAM between heap and stack pointer
+};
+
+// Times the enclosing interrupt handler, including early returns
+class CDiagnosticsScope
+{
+    public:
+
+    CDiagnosticsScope(const DiagnosticsIsr isr)
+    : m_isr(isr)
+    , m_begin(TCNT0)
+    {
+        // empty
+    }
+
+    ~CDiagnosticsScope(void);
+
+    private:
+
+    const DiagnosticsIsr m_isr;
+    const uint8_t m_begin;
+};
+
+// Times the enclosing section that blocks the main loop
+class CDiagnosticsBlock
+{
+    public:
+
+    CDiagnosticsBlock(void)
+    : m_begin(micros())
+    {
+        // empty
+    }
+
+    ~CDiagnosticsBlock(void);
+
+    private:
+
+    const uint32_t m_begin;
+};
+
+void DiagnosticsLoopBegin(void);
+void DiagnosticsLoopEnd(void);
+void DiagnosticsLoopDiscard(void);
+void GetDiagnostics(DiagnosticsStruct& diagnostics);
+void FormatDiagnostics(char* s, const uint8_t page);
+
+#define diagnosticsIsr(isr)         CDiagnosticsScope diagnostics_scope(isr)
+#define diagnosticsBlock()          CDiagnosticsBlock diagnostics_block
+#define diagnosticsLoopBegin()      DiagnosticsLoopBegin()
+#define diagnosticsLoopEnd()        DiagnosticsLoopEnd()
+#define diagnosticsLoopDiscard()    DiagnosticsLoopDiscard()
+
+#else
+
+const uint8_t DIAGNOSTICS_PAGES = 0;
+
+#define diagnosticsIsr(isr)
+#define diagnosticsBlock()
+#define diagnosticsLoopBegin()
+#define diagnosticsLoopEnd()
+#define diagnosticsLoopDiscard()
+
+#endif
+
+#endif
@@ -0,0 +1,454 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Discipline.cpp
+ * @summary     DS3232 time discipline from an external reference for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include "Discipline.h"
+
+extern CDS3232 g_rtc;               // class
+extern volatile uint16_t g_second_stamp; // integral
+extern volatile bool g_second_wired; // integral
+
+enum class NmeaSentence : uint8_t
+{
+    OTHER,
+    RMC,    // Status field must be 'A' (valid)
+    ZDA,
+};
+
+// Streaming sentence parser - nothing is buffered
+struct NmeaStateStruct
+{
+    NmeaStateStruct()
+    : active(false)
+    , star(false)
+    , valid(false)
+    , sentence(NmeaSentence::OTHER)
+    , field(0)
+    , index(0)
+    , length(0)
+    , sum(0)
+    , check(0)
+    , digits(0)
+    , hundredths(0)
+    , time(0)
+    , stamp(0)
+    {
+        // empty
+    }
+
+    bool        active;     // Between '$' and end of line
+    bool        star;       // Checksum digits follow
+    bool        valid;
+    NmeaSentence sentence;
+    uint8_t     field;
+    uint8_t     index;      // Character within field
+    uint8_t     length;
+    uint8_t     sum;        // XOR of characters after '$'
+    uint8_t     check;      // Transmitted checksum
+    uint8_t     digits;     // Time digits received
+    uint8_t     hundredths;
+    uint32_t    time;       // Sentence name, then hhmmss
+    uint16_t    stamp;      // Arrival of '$'
+};
+
+static const uint32_t NMEA_RMC = (((uint32_t)'R' << 16) | ('M' << 8) | 'C');
+static const uint32_t NMEA_ZDA = (((uint32_t)'Z' << 16) | ('D' << 8) | 'A');
+
+static NmeaStateStruct s_nmea;
+static DisciplineStatusStruct s_status;
+
+// Reference waiting for the next tick
+static bool s_reference = false;
+static uint32_t s_reference_seconds = UINT32_MAX;
+static uint16_t s_reference_milliseconds = 0;
+static uint16_t s_reference_stamp = 0;
+
+// Medians of the current interval, split in halves for the first frequency estimate
+static int32_t s_filter[DISCIPLINE_FILTER];
+static uint8_t s_filtered = 0;
+static int32_t s_sum[2] = {0, 0};
+static uint16_t s_count[2] = {0, 0};
+static uint16_t s_seconds = 0;
+static uint8_t s_beyond = 0; // Consecutive medians beyond DISCIPLINE_STEP
+static int32_t s_integral = 0; // Frequency in ppb
+static bool s_locked = false;
+
+// Step scheduled by DisciplineTick() and written by DisciplineUpdate()
+static bool s_step = false;
+static uint32_t s_step_time = 0; // millis()
+static int32_t s_step_seconds = 0;
+
+
+static int32_t Divide(const int32_t value, const int32_t divisor)
+{
+    return ((value < 0) ? (value - (divisor / 2)) : (value + (divisor / 2))) / divisor;
+}
+
+
+static void ResetInterval(void)
+{
+    s_sum[0] = s_sum[1] = 0;
+    s_count[0] = s_count[1] = 0;
+    s_filtered = 0;
+    s_seconds = 0;
+    s_beyond = 0;
+    s_status.samples = 0;
+}
+
+
+static void WriteAging(const int8_t aging)
+{
+    if (aging != s_status.aging)
+    {
+        uint8_t value = aging;
+        g_rtc.WriteRegister(DS3232_REGISTER_AGING, &value, 1); // Applied at next conversion
+        s_status.aging = aging;
+    }
+}
+
+
+// PI loop on the mean phase of the interval - output is the aging offset
+static void Steer(void)
+{
+    uint16_t count = (s_count[0] + s_count[1]);
+
+    if ((count >= DISCIPLINE_MEDIANS) && s_count[0] && s_count[1])
+    {
+        int32_t mean = ((s_sum[0] + s_sum[1]) / count);
+        int32_t proportional = ((mean * 1000) / DISCIPLINE_INTERVAL); // ppb
+
+        if (!s_locked)
+        {
+            // Phase slope between the halves acquires frequency in one interval
+            // Phase gathered meanwhile is pulled in slowly by later intervals
+            int32_t slope = ((s_sum[1] / s_count[1]) - (s_sum[0] / s_count[0]));
+            s_integral += ((slope * 2000) / DISCIPLINE_INTERVAL);
+            s_locked = true;
+            proportional = 0;
+        }
+
+        int32_t limit = (127L * DISCIPLINE_AGING_PPB);
+        int32_t aging = Divide((s_integral + (proportional / 4)), DISCIPLINE_AGING_PPB);
+        s_integral += (proportional / 32);
+        s_integral = (s_integral > limit) ? limit : ((s_integral < -limit) ? -limit : s_integral);
+        s_status.offset = mean;
+        s_status.drift = s_integral;
+        WriteAging((aging > 127) ? 127 : ((aging < -127) ? -127 : aging));
+        s_status.updates++;
+    }
+
+    ResetInterval(); // Too few samples holds the aging offset
+}
+
+
+// Align the clock to the reference at the next whole reference second
+static void ScheduleStep(const uint32_t seconds, const uint16_t edge, const int32_t phase)
+{
+    uint32_t now = millis();
+    uint32_t base = ((now - (uint16_t)((uint16_t)now - edge)) + Divide(phase, 1000));
+    int32_t late = (int32_t)((now + 2) - base); // Register write follows within 2ms
+    int32_t whole = (late > 0) ? ((late + 999) / 1000) : -(-late / 1000);
+
+    s_step = true;
+    s_step_time = (base + (whole * 1000));
+    s_step_seconds = (seconds + whole);
+    ResetInterval();
+}
+
+
+static void Sample(const uint32_t seconds, const uint16_t edge)
+{
+    int16_t elapsed = (int16_t)(s_reference_stamp - edge);
+
+    // Sentences starting just before the edge complete after its tick
+    if ((elapsed <= -2000) || (elapsed >= 1000))
+    {
+        return;
+    }
+
+    // Local time differs from UTC by whole quarter hours
+    int32_t zone = DISCIPLINE_ZONE;
+    int32_t offset = (((int32_t)seconds - (int32_t)s_reference_seconds) % zone);
+    offset = (offset >= (zone / 2)) ? (offset - zone) : ((offset < -(zone / 2)) ? (offset + zone) : offset);
+
+    int32_t phase = ((offset * 1000000) + (elapsed * 1000L) - (s_reference_milliseconds * 1000L));
+    int32_t half = ((zone / 2) * 1000000);
+    phase = (phase >= half) ? (phase - (2 * half)) : ((phase < -half) ? (phase + (2 * half)) : phase);
+    s_filter[s_filtered++] = phase;
+    s_status.samples++;
+
+    if (s_filtered < DISCIPLINE_FILTER)
+    {
+        return;
+    }
+
+    // Insertion sort - few enough samples
+    for (uint8_t index = 1; index < DISCIPLINE_FILTER; index++)
+    {
+        int32_t value = s_filter[index];
+        uint8_t position = index;
+
+        for (; (position > 0) && (s_filter[position - 1] > value); position--)
+        {
+            s_filter[position] = s_filter[position - 1];
+        }
+
+        s_filter[position] = value;
+    }
+
+    phase = s_filter[DISCIPLINE_FILTER / 2];
+    s_filtered = 0;
+    s_status.phase = phase;
+
+    if ((phase > DISCIPLINE_STEP) || (phase < -DISCIPLINE_STEP))
+    {
+        if (++s_beyond >= DISCIPLINE_STEP_COUNT)
+        {
+            ScheduleStep(seconds, edge, phase);
+        }
+
+        return;
+    }
+
+    uint8_t index = (s_seconds >= (DISCIPLINE_INTERVAL / 2));
+    s_beyond = 0;
+    s_sum[index] += phase;
+    s_count[index]++;
+}
+
+
+// Seed the loop from the aging offset kept by the DS3232
+void DisciplineInitialize(void)
+{
+    uint8_t value = 0;
+
+    g_rtc.ReadRegister(DS3232_REGISTER_AGING, &value, 1);
+    s_status.aging = value;
+    s_integral = (s_status.aging * DISCIPLINE_AGING_PPB);
+    s_locked = (s_status.aging != 0); // Frequency already acquired
+}
+
+
+// Reference second of day and milliseconds valid at stamp
+void DisciplineReference(const uint32_t seconds, const uint16_t milliseconds, const uint16_t stamp)
+{
+    if ((seconds == s_reference_seconds) && (milliseconds == s_reference_milliseconds))
+    {
+        return; // Later sentences of one second leave behind the first
+    }
+
+    s_reference = true;
+    s_reference_seconds = seconds;
+    s_reference_milliseconds = milliseconds;
+    s_reference_stamp = stamp;
+}
+
+
+// Time of an RMC or ZDA sentence applies to the arrival of its '$'
+// Receiver output latency is seen as a constant phase offset
+void DisciplineNmea(const uint8_t data, const uint16_t stamp)
+{
+    if (data == '$')
+    {
+        s_nmea = NmeaStateStruct();
+        s_nmea.active = true;
+        s_nmea.stamp = stamp;
+        return;
+    }
+
+    if (!s_nmea.active)
+    {
+        return;
+    }
+
+    if (++s_nmea.length > (DISCIPLINE_NMEA_LENGTH - 2)) // '$' and LF not counted
+    {
+        s_nmea.active = false;
+        return;
+    }
+
+    if ((data == '\r') || (data == '\n'))
+    {
+        s_nmea.active = false;
+
+        if (s_nmea.star && (s_nmea.index == 2) && (s_nmea.check == s_nmea.sum) && (s_nmea.digits == 6)
+            && ((s_nmea.sentence == NmeaSentence::ZDA) || ((s_nmea.sentence == NmeaSentence::RMC) && s_nmea.valid)))
+        {
+            uint8_t hour = (s_nmea.time / 10000);
+            uint8_t minute = ((s_nmea.time / 100) % 100);
+            uint8_t second = (s_nmea.time % 100);
+
+            if ((hour < 24) && (minute < 60) && (second < 60))
+            {
+                DisciplineReference(GetSeconds(hour, minute, second), (s_nmea.hundredths * 10), s_nmea.stamp);
+            }
+        }
+
+        return;
+    }
+
+    if (s_nmea.star)
+    {
+        uint8_t nibble = ((data >= '0') && (data <= '9')) ? (data - '0')
+                       : (((data >= 'A') && (data <= 'F')) ? (data - 'A' + 10) : 0xFF);
+        s_nmea.active = ((nibble != 0xFF) && (s_nmea.index < 2));
+        s_nmea.check = ((s_nmea.check << 4) | nibble);
+        s_nmea.index++;
+        return;
+    }
+
+    if (data == '*')
+    {
+        s_nmea.star = true;
+        s_nmea.index = 0;
+        return;
+    }
+
+    s_nmea.sum ^= data;
+
+    if (data == ',')
+    {
+        if (s_nmea.field == 0)
+        {
+            // Any talker - $GPRMC, $GNZDA
+            s_nmea.sentence = (s_nmea.time == NMEA_RMC) ? NmeaSentence::RMC
+                            : ((s_nmea.time == NMEA_ZDA) ? NmeaSentence::ZDA : NmeaSentence::OTHER);
+            s_nmea.time = 0;
+        }
+
+        s_nmea.field++;
+        s_nmea.index = 0;
+        return;
+    }
+
+    switch (s_nmea.field)
+    {
+    case 0: // Last three characters name the sentence
+        s_nmea.time = (((s_nmea.time << 8) | data) & 0xFFFFFF);
+        break;
+    case 1: // hhmmss.ss
+        if ((data >= '0') && (data <= '9') && (s_nmea.index < 6))
+        {
+            s_nmea.time = ((s_nmea.time * 10) + (data - '0'));
+            s_nmea.digits++;
+        }
+        else if ((data >= '0') && (data <= '9') && (s_nmea.index < 9))
+        {
+            s_nmea.hundredths += ((data - '0') * ((s_nmea.index == 7) ? 10 : 1));
+        }
+        else if ((data != '.') || (s_nmea.index != 6))
+        {
+            s_nmea.sentence = NmeaSentence::OTHER;
+        }
+        break;
+    case 2: // RMC status
+        s_nmea.valid = ((s_nmea.index == 0) && (data == 'A'));
+        break;
+    default:
+        break;
+    }
+
+    s_nmea.index++;
+}
+
+
+// Called once per RTC second after the registers are read
+void DisciplineTick(const CRTC::RTC& rtc)
+{
+    uint16_t now = millis();
+    uint16_t edge;
+
+    cli();
+    edge = g_second_stamp;
+    sei();
+
+    // Registers read after an alarm wake or menu have no fresh edge
+    if ((uint16_t)(now - edge) >= 1000)
+    {
+        s_reference = false;
+        return;
+    }
+
+    uint32_t seconds = GetSeconds(rtc.hour, rtc.minute, rtc.second);
+    s_seconds++;
+
+    if (s_reference && !s_step)
+    {
+        Sample(seconds, edge);
+    }
+
+    s_reference = false;
+
+    if (s_seconds >= DISCIPLINE_INTERVAL)
+    {
+        Steer();
+    }
+}
+
+
+// Writes a scheduled step - returns milliseconds until it is due
+uint16_t DisciplineUpdate(void)
+{
+    if (!s_step)
+    {
+        return UINT16_MAX;
+    }
+
+    int32_t remaining = (int32_t)(s_step_time - millis());
+
+    if (remaining > 0)
+    {
+        return remaining;
+    }
+
+    // Late by whole seconds when the loop was held up
+    int32_t seconds = (s_step_seconds + (-remaining / 1000));
+    s_step = false;
+
+    if ((seconds >= 0) && (seconds < 86400L))
+    {
+        g_rtc.SetTime((seconds / 3600), ((seconds / 60) % 60), (seconds % 60)); // Resets the second countdown
+        s_status.steps++;
+        ScheduleEvent(); // Alarms and blanking follow the new clock
+    }
+
+    ResetInterval(); // Crossing midnight waits for the next samples
+    return UINT16_MAX;
+}
+
+
+// Timer0 halts in power-down - a step waits on millis()
+bool DisciplineIsIdle(void)
+{
+    return !s_step;
+}
+
+
+void GetDisciplineStatus(DisciplineStatusStruct& status)
+{
+    status = s_status;
+    status.sqw = g_second_wired;
+}
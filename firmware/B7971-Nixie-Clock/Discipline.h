@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Discipline.h
+ * @summary     DS3232 time discipline from an external reference for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _DISCIPLINE_H
+#define _DISCIPLINE_H
+
+#include "B7971-Nixie-Clock.h"
+
+const uint16_t DISCIPLINE_INTERVAL = 3600; // Seconds of phase samples per aging update
+const uint8_t DISCIPLINE_FILTER = 5; // Samples per median - rejects late and early arrivals
+const uint16_t DISCIPLINE_MEDIANS = (DISCIPLINE_INTERVAL / DISCIPLINE_FILTER / 4); // Fewer holds the aging offset
+const int32_t DISCIPLINE_STEP = 100000; // Phase error in microseconds stepped instead of steered
+const uint8_t DISCIPLINE_STEP_COUNT = 6; // Consecutive medians beyond DISCIPLINE_STEP
+const uint16_t DISCIPLINE_ZONE = 900; // Seconds - time zones are whole quarter hours
+const int16_t DISCIPLINE_AGING_PPB = 100; // Frequency change per aging LSB at 25C
+const uint8_t DISCIPLINE_NMEA_LENGTH = 82; // Longest sentence including $ and CR LF
+
+// Reported over the serial protocol - positive phase is a clock running ahead
+struct DisciplineStatusStruct
+{
+    DisciplineStatusStruct()
+    : phase(0)
+    , offset(0)
+    , drift(0)
+    , aging(0)
+    , samples(0)
+    , updates(0)
+    , steps(0)
+    , sqw(0)
+    {
+        // empty
+    }
+
+    int32_t     phase;      // Last median in microseconds
+    int32_t     offset;     // Mean of the last interval in microseconds
+    int32_t     drift;      // Estimated oscillator error in ppb, corrected by aging
+    int8_t      aging;      // DS3232 aging register
+    uint16_t    samples;    // Samples in the current interval
+    uint16_t    updates;    // Aging updates since reset
+    uint16_t    steps;      // Clock steps since reset
+    uint8_t     sqw;        // 0 until an INT/SQW edge is seen - no phase samples without it
+} __attribute__((packed));
+
+void DisciplineInitialize(void);
+void DisciplineReference(const uint32_t seconds, const uint16_t milliseconds, const uint16_t stamp);
+void DisciplineNmea(const uint8_t data, const uint16_t stamp);
+void DisciplineTick(const CRTC::RTC& rtc);
+uint16_t DisciplineUpdate(void);
+bool DisciplineIsIdle(void);
+void GetDisciplineStatus(DisciplineStatusStruct& status);
+
+#endif
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Format.cpp
+ * @summary     Fixed-width display formatting for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include "Format.h"
+
+
+// Two ASCII digits for 0-99 - multiply and shift instead of division
+void FormatDigits(char* s, const uint8_t value)
+{
+    uint8_t tens = (((uint16_t)value * 205) >> 11); // value / 10, exact up to 179
+
+    s[0] = ('0' + tens);
+    s[1] = ('0' + (value - (tens * 10)));
+}
+
+
+// Three two-digit fields as a terminated display string
+void FormatFields(char* s, const uint8_t field0, const uint8_t field1, const uint8_t field2)
+{
+    FormatDigits(&s[0], field0);
+    FormatDigits(&s[2], field1);
+    FormatDigits(&s[4], field2);
+    s[DISPLAY_COUNT] = '\0';
+}
+
+
+// Right aligned value in width characters, leading positions filled with pad
+void FormatDecimal(char* s, uint16_t value, const uint8_t width, const char pad)
+{
+    for (uint8_t index = width; index-- > 0;)
+    {
+        s[index] = ((value || (index == (width - 1))) ? ('0' + (value % 10)) : pad);
+        value /= 10;
+    }
+}
+
+
+// Celsius Q8.2 temperature as "0222`C" in tenths - caller lights the decimal point of unit 2
+void FormatTemperature(char* s, const int16_t temperature, const CRTC::Unit unit)
+{
+    int16_t value = CRTC::ConvertTemperature(temperature, CRTC::Unit::C, unit);
+    uint16_t magnitude = (value < 0) ? -value : value;
+
+    FormatDecimal(s, ((magnitude * 10) / DS3232_TEMPERATURE_ONE), 4, '0');
+
+    if (value < 0)
+    {
+        s[0] = '-';
+    }
+
+    s[4] = '`';
+    s[5] = (unit == CRTC::Unit::F) ? 'F' : 'C';
+    s[DISPLAY_COUNT] = '\0';
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Frame.cpp
+ * @summary     Display frame composition for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include "Frame.h"
+
+extern CDisplay g_display;          // class
+
+struct FrameContentStruct
+{
+    uint8_t value[DISPLAY_COUNT];
+    uint8_t brightness[DISPLAY_COUNT];
+    uint8_t indicator[DISPLAY_COUNT];
+    uint8_t ambient;
+};
+
+// BCM duty per brightness level - bit N enables bit-plane N
+// AUTO (index 0) is replaced by the ambient duty from SetFrameAmbient()
+static const uint8_t brightness_duty[] PROGMEM = {63, 8, 16, 24, 32, 40, 48, 56, 63};
+
+// Bit-planes are stored in shift order: tube 5 first, MSB first
+static uint8_t s_frame[2][FRAME_PLANES][FRAME_BYTES];
+// First bit-plane with identical content, tagged with buffer in bit 3
+static uint8_t s_canonical[2][FRAME_PLANES];
+static uint8_t s_latched = 0xFF; // Canonical tag of data held in HV5622 latches
+static FrameStatisticsStruct s_statistics;
+static FrameContentStruct s_content;
+static volatile uint8_t s_front = 0;
+static volatile bool s_pending = false;
+static bool s_valid = false;
+static uint8_t s_ambient = FRAME_DUTY_MAX;
+
+
+// Compose back buffer from CDisplay content when it has changed
+void UpdateFrame(void)
+{
+    FrameContentStruct content;
+
+    for (uint8_t tube = 0; tube < DISPLAY_COUNT; tube++)
+    {
+        content.value[tube] = g_display.GetUnitValue(tube);
+        content.brightness[tube] = getValue(g_display.GetUnitBrightness(tube));
+        content.indicator[tube] = g_display.GetUnitIndicator(tube);
+    }
+
+    content.ambient = s_ambient;
+
+    if (s_valid && !memcmp(&content, &s_content, sizeof(content)))
+    {
+        return; // No change
+    }
+
+    s_pending = false; // Prevent swap while back buffer is written
+    uint8_t back = (s_front ^ 0x1);
+
+    for (uint8_t tube = 0; tube < DISPLAY_COUNT; tube++)
+    {
+        uint8_t offset = (DISPLAY_COUNT - 1 - tube) * 2;
+        uint8_t brightness = content.brightness[tube];
+        uint8_t duty = (brightness == getValue(CDisplay::Brightness::AUTO))
+                     ? content.ambient : pgm_read_byte(&brightness_duty[brightness]);
+        uint16_t digit_bitmap = (pgm_read_word_near(BITMAP + content.value[tube] - 24)
+                              | (content.indicator[tube] << 1));
+
+        for (uint8_t plane = 0; plane < FRAME_PLANES; plane++)
+        {
+            uint16_t bitmap = ((duty >> plane) & 0x1) ? digit_bitmap : 0;
+            s_frame[back][plane][offset] = (bitmap >> 8);
+            s_frame[back][plane][offset + 1] = (bitmap & 0xFF);
+        }
+    }
+
+    for (uint8_t plane = 0; plane < FRAME_PLANES; plane++)
+    {
+        uint8_t canonical = plane;
+
+        for (uint8_t previous = 0; previous < plane; previous++)
+        {
+            if (!memcmp(s_frame[back][previous], s_frame[back][plane], FRAME_BYTES))
+            {
+                canonical = previous;
+                break;
+            }
+        }
+
+        s_canonical[back][plane] = ((back << 3) | canonical);
+    }
+
+    s_content = content;
+    s_valid = true;
+    s_pending = true; // Swap on next frame boundary
+}
+
+
+// Duty (0-63) applied to units at CDisplay::Brightness::AUTO
+void SetFrameAmbient(const uint8_t duty)
+{
+    s_ambient = (duty > FRAME_DUTY_MAX) ? FRAME_DUTY_MAX : duty;
+}
+
+
+// Called from display ISR - returns bit-plane stream ready to shift
+// or nullptr if the HV5622 latches already hold identical data
+const uint8_t* GetFramePlane(const uint8_t plane)
+{
+    if ((plane == 0) && s_pending)
+    {
+        s_front ^= 0x1;
+        s_pending = false;
+    }
+
+    uint8_t canonical = s_canonical[s_front][plane];
+
+    if (canonical == s_latched)
+    {
+        s_statistics.skipped++;
+        return nullptr;
+    }
+
+    s_latched = canonical;
+    s_statistics.shifted++;
+    return s_frame[s_front][plane];
+}
+
+
+void GetFrameStatistics(FrameStatisticsStruct& statistics)
+{
+    cli();
+    statistics = s_statistics;
+    sei();
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Frame.h
+ * @summary     Display frame composition for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _FRAME_H
+#define _FRAME_H
+
+#include "B7971-Nixie-Clock.h"
+
+const uint8_t FRAME_PLANES = 6; // BCM bit-planes per frame
+const uint8_t FRAME_BYTES = (DISPLAY_COUNT * 2); // 16 segments per tube
+const uint8_t FRAME_DUTY_MAX = ((1 << FRAME_PLANES) - 1);
+
+struct FrameStatisticsStruct
+{
+    FrameStatisticsStruct()
+    : shifted(0)
+    , skipped(0)
+    {
+        // empty
+    }
+
+    uint32_t shifted;   // Bit-planes clocked into the HV5622 chain
+    uint32_t skipped;   // Bit-planes identical to the latched data
+};
+
+void UpdateFrame(void);
+void SetFrameAmbient(const uint8_t duty);
+void GetFrameStatistics(FrameStatisticsStruct& statistics);
+const uint8_t* GetFramePlane(const uint8_t plane);
+
+#endif
@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Input.cpp
+ * @summary     Timestamped encoder and button events for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include "Input.h"
+#include "Supervisor.h"
+
+extern CNcoder g_encoder;           // class
+
+static_assert((INPUT_QUEUE & (INPUT_QUEUE - 1)) == 0, "Input queue size");
+
+// Upper bound of each detent interval band in milliseconds
+static const uint8_t curve_interval[INPUT_RATE_BANDS] PROGMEM = {30, 60, 120};
+
+// Steps per detent within each band - slower detents take a single step
+static const uint8_t curve_steps[getValue(InputCurve::COUNT)][INPUT_RATE_BANDS] PROGMEM =
+{
+    [getValue(InputCurve::LINEAR)] = {1, 1, 1},
+    [getValue(InputCurve::GENTLE)] = {4, 2, 1},
+    [getValue(InputCurve::STEEP)]  = {8, 4, 2},
+};
+
+// Filled by InputTick() only, drained by the main loop only - each index has one writer
+static InputEventStruct s_queue[INPUT_QUEUE];
+static volatile uint8_t s_head = 0; // Next slot written
+static volatile uint8_t s_tail = 0; // Next slot read
+static volatile uint8_t s_detent[2] = {0, 0}; // Detents counted by the encoder callback, CW and CCW
+static volatile uint8_t s_detent_queued[2] = {0, 0}; // Detents pushed by InputTick()
+static volatile bool s_down = false; // Button state seen by InputTick()
+static bool s_held = false; // Button state as of the last event popped
+static bool s_selected = false; // PRESS popped by a prompt, not yet returned by InputSelect()
+static bool s_long = false; // LONG_PRESS sent for this press
+static uint16_t s_edge = 0; // Time of last button edge
+static uint16_t s_click = 0; // Time of last CLICK
+static bool s_clicked = false; // s_click may pair with the next click
+static bool s_increment = false; // Direction of last step
+static uint16_t s_rotate = 0; // Time of last detent stepped
+static uint8_t s_repeat = 0; // Steps left from last detent
+static InputCurve s_curve = InputCurve::LINEAR;
+
+
+// Called from InputTick() only - newest events are dropped when full
+// Slot is filled before s_head publishes it, so no lock is needed
+static void Push(const InputType type, const uint16_t time)
+{
+    uint8_t head = s_head;
+
+    if ((uint8_t)(head - s_tail) < INPUT_QUEUE)
+    {
+        s_queue[head & (INPUT_QUEUE - 1)].type = type;
+        s_queue[head & (INPUT_QUEUE - 1)].time = time;
+        s_head = (head + 1);
+    }
+}
+
+
+// Called from the CNcoder callback - counted here, queued by the next InputTick()
+void InputRotate(const CNcoder::Rotation rotation)
+{
+    s_detent[(rotation == CNcoder::Rotation::CW) ? 0 : 1]++;
+}
+
+
+// Called from millisecond interrupt - queues detents and derives button gestures
+void InputTick(void)
+{
+    bool down = (g_encoder.GetButtonState() == CNcoder::Button::DOWN);
+    uint16_t now = millis();
+
+    // Detents in the same tick share its time
+    while (s_detent_queued[0] != s_detent[0])
+    {
+        s_detent_queued[0]++;
+        Push(InputType::INCREMENT, now);
+    }
+
+    while (s_detent_queued[1] != s_detent[1])
+    {
+        s_detent_queued[1]++;
+        Push(InputType::DECREMENT, now);
+    }
+
+    if (down != s_down)
+    {
+        s_down = down;
+        s_edge = now;
+        Push(down ? InputType::PRESS : InputType::RELEASE, now);
+
+        if (!down && !s_long)
+        {
+            Push(InputType::CLICK, now);
+
+            if (s_clicked && ((uint16_t)(now - s_click) < INPUT_DOUBLE_CLICK))
+            {
+                Push(InputType::DOUBLE_CLICK, now);
+                s_clicked = false; // Third click starts a new pair
+            }
+            else
+            {
+                s_click = now;
+                s_clicked = true;
+            }
+        }
+
+        s_long = false;
+    }
+    else if (down && !s_long && ((uint16_t)(now - s_edge) >= INPUT_LONG_PRESS))
+    {
+        s_long = true;
+        Push(InputType::LONG_PRESS, now);
+    }
+}
+
+
+bool InputPop(InputEventStruct& event)
+{
+    uint8_t tail = s_tail;
+
+    if (tail == s_head)
+    {
+        return false;
+    }
+
+    event = s_queue[tail & (INPUT_QUEUE - 1)];
+    s_tail = (tail + 1); // Release slot after copy
+
+    if ((event.type == InputType::PRESS) || (event.type == InputType::RELEASE))
+    {
+        s_held = (event.type == InputType::PRESS);
+    }
+
+    SupervisorCheckIn(SupervisorTask::MENU); // Open menus live while input arrives
+    return true;
+}
+
+
+// Wait for an event - returns false after timeout milliseconds
+// Polls with delay() as WaitEvent() returns early while a second tick is pending
+bool InputWait(InputEventStruct& event, const uint16_t timeout)
+{
+    uint16_t start = millis();
+
+    while (!InputPop(event))
+    {
+        SupervisorCheckIn(SupervisorTask::LOOP); // Polled like a prompt
+
+        if ((uint16_t)(millis() - start) >= timeout)
+        {
+            return false;
+        }
+
+        delay(1);
+    }
+
+    return true;
+}
+
+
+// Returns true on release, false if the button is held for a long press
+bool InputWaitRelease(void)
+{
+    InputEventStruct event;
+
+    while (InputIsPending() || s_down)
+    {
+        if (!InputWait(event, INPUT_LONG_PRESS))
+        {
+            continue; // Still held, LONG_PRESS was dropped
+        }
+
+        if (event.type == InputType::RELEASE)
+        {
+            return true;
+        }
+
+        if (event.type == InputType::LONG_PRESS)
+        {
+            return false;
+        }
+    }
+
+    return true; // Released while events were flushed
+}
+
+
+// Returns true once per value step - fast detents repeat per the active curve
+// Presses are kept for InputSelect(), other button gestures are discarded
+bool InputStep(void)
+{
+    InputEventStruct event;
+
+    if (s_repeat)
+    {
+        s_repeat--;
+        return true;
+    }
+
+    while (InputPop(event))
+    {
+        if (event.type == InputType::PRESS)
+        {
+            s_selected = true;
+        }
+        else if ((event.type == InputType::INCREMENT) || (event.type == InputType::DECREMENT))
+        {
+            bool increment = (event.type == InputType::INCREMENT);
+            uint16_t interval = (event.time - s_rotate);
+            uint8_t steps = 1;
+
+            // Reversal always takes a single step
+            for (uint8_t band = 0; (increment == s_increment) && (band < INPUT_RATE_BANDS); band++)
+            {
+                if (interval < pgm_read_byte(&curve_interval[band]))
+                {
+                    steps = pgm_read_byte(&curve_steps[getValue(s_curve)][band]);
+                    break;
+                }
+            }
+
+            s_increment = increment;
+            s_rotate = event.time;
+            s_repeat = (steps - 1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+// Returns true once per queued press, then while that press is held
+// Events ahead of the next detent are read, so a click between polls is not missed
+bool InputSelect(void)
+{
+    InputEventStruct event;
+
+    while (s_tail != s_head)
+    {
+        InputType type = s_queue[s_tail & (INPUT_QUEUE - 1)].type;
+
+        if ((type == InputType::INCREMENT) || (type == InputType::DECREMENT))
+        {
+            break; // Left for InputStep()
+        }
+
+        InputPop(event);
+        s_selected |= (event.type == InputType::PRESS);
+    }
+
+    if (s_selected)
+    {
+        s_selected = false;
+        return true;
+    }
+
+    return s_held;
+}
+
+
+// Direction of last step returned by InputStep()
+bool InputIsIncrement(void)
+{
+    return s_increment;
+}
+
+
+// Direction reported by InputIsIncrement() until the next step
+void InputSetDirection(const bool increment)
+{
+    s_increment = increment;
+    s_repeat = 0;
+}
+
+
+// Acceleration applied by InputStep() until changed
+void InputSetCurve(const InputCurve curve)
+{
+    s_curve = curve;
+    s_repeat = 0;
+}
+
+
+bool InputIsPending(void)
+{
+    return (s_tail != s_head);
+}
+
+
+// Timer0 halts in power-down - counted detents wait for InputTick()
+bool InputIsIdle(void)
+{
+    return ((s_detent[0] == s_detent_queued[0]) && (s_detent[1] == s_detent_queued[1]));
+}
+
+
+// Discard events queued while input was not being read
+void InputFlush(void)
+{
+    s_tail = s_head;
+    s_repeat = 0;
+    s_selected = false;
+    s_held = s_down; // Its RELEASE is still to come
+}
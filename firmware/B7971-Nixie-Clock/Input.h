@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Input.h
+ * @summary     Timestamped encoder and button events for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _INPUT_H
+#define _INPUT_H
+
+#include "B7971-Nixie-Clock.h"
+
+const uint8_t INPUT_QUEUE = 16; // Power of two
+const uint16_t INPUT_LONG_PRESS = 1000; // Milliseconds held
+const uint16_t INPUT_DOUBLE_CLICK = 400; // Milliseconds between releases
+const uint16_t INPUT_INFO_TIMEOUT = 5000; // Milliseconds without a press
+const uint16_t INPUT_VIEW_TIMEOUT = 30000; // Milliseconds without input
+const uint8_t INPUT_RATE_BANDS = 3; // Detent intervals with their own step count
+
+enum class InputType : uint8_t
+{
+    INCREMENT,      // Encoder step clockwise
+    DECREMENT,      // Encoder step counter-clockwise
+    PRESS,          // Button edges
+    RELEASE,
+    CLICK,          // Released before INPUT_LONG_PRESS
+    DOUBLE_CLICK,   // Second click within INPUT_DOUBLE_CLICK, follows its CLICK
+    LONG_PRESS,     // Held for INPUT_LONG_PRESS, once per press
+};
+
+// Value steps applied per detent, chosen by time since the previous detent
+enum class InputCurve : uint8_t
+{
+    LINEAR,     // One step per detent
+    GENTLE,     // Up to 4 steps - ranges below 100
+    STEEP,      // Up to 8 steps - character sets
+    COUNT,
+};
+
+struct InputEventStruct
+{
+    InputEventStruct()
+    : type(InputType::RELEASE)
+    , time(0)
+    {
+        // empty
+    }
+
+    InputType   type;
+    uint16_t    time;   // millis() when the event occurred
+};
+
+void InputRotate(const CNcoder::Rotation rotation);
+void InputTick(void);
+bool InputPop(InputEventStruct& event);
+bool InputWait(InputEventStruct& event, const uint16_t timeout);
+bool InputWaitRelease(void);
+bool InputStep(void);
+bool InputSelect(void);
+bool InputIsIncrement(void);
+void InputSetDirection(const bool increment);
+void InputSetCurve(const InputCurve curve);
+bool InputIsPending(void);
+bool InputIsIdle(void);
+void InputFlush(void);
+
+#endif
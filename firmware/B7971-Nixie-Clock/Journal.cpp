@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Journal.cpp
+ * @summary     Wear-levelled EEPROM journal for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include <util/crc16.h>
+#include "Journal.h"
+
+// EEPROM is divided into slots, each holding one record. Records are
+// appended at the head, which skips slots holding the newest record of
+// a chunk, so every other slot is rewritten once per lap of the ring.
+struct JournalRecordStruct
+{
+    uint16_t    sequence;   // Newest record of a chunk wins
+    uint8_t     chunk;      // JOURNAL_CHUNKS or above is invalid
+    uint8_t     data[JOURNAL_CHUNK_BYTES];
+    uint8_t     crc;
+};
+
+static_assert(sizeof(JournalRecordStruct) == JOURNAL_RECORD_BYTES, "Journal record size");
+static_assert(JOURNAL_CHUNKS <= 32, "Journal dirty mask");
+static_assert(JOURNAL_CHUNKS < JOURNAL_SLOTS, "Journal capacity");
+static_assert(((uint32_t)JOURNAL_REFRESH * JOURNAL_CHUNKS + JOURNAL_SLOTS) < 32768, "Journal sequence window");
+
+static uint8_t s_image[JOURNAL_IMAGE_BYTES]; // Image as last written
+static uint8_t s_location[JOURNAL_CHUNKS]; // Slot of newest record per chunk
+static volatile uint32_t s_dirty = 0; // Chunks awaiting a record
+static JournalRecordStruct s_record; // Record being written
+static uint8_t s_record_index = JOURNAL_RECORD_BYTES; // Next byte of s_record
+static bool s_writing = false;
+static uint8_t s_head = 0; // Slot of s_record
+static uint16_t s_sequence = 0;
+static JournalStatisticsStruct s_statistics;
+
+
+static uint8_t RecordCRC(const JournalRecordStruct& record)
+{
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(&record);
+    uint8_t crc = 0xFF; // Zeroed record is invalid
+
+    for (uint8_t index = 0; index < offsetof(JournalRecordStruct, crc); index++)
+    {
+        crc = _crc8_ccitt_update(crc, data[index]);
+    }
+
+    return crc;
+}
+
+
+static bool IsSlotLive(const uint8_t slot)
+{
+    for (uint8_t chunk = 0; chunk < JOURNAL_CHUNKS; chunk++)
+    {
+        if (s_location[chunk] == slot)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+// Called with interrupts disabled - stage next dirty chunk
+static bool BeginRecord(void)
+{
+    if (!s_dirty)
+    {
+        return false;
+    }
+
+    // Rewrite each chunk in turn so no live record falls half the
+    // sequence space behind, where the newest could not be told apart
+    if (!(s_sequence % JOURNAL_REFRESH))
+    {
+        s_dirty |= (1UL << ((s_sequence / JOURNAL_REFRESH) % JOURNAL_CHUNKS));
+    }
+
+    uint8_t chunk = 0;
+
+    while (!(s_dirty & (1UL << chunk)))
+    {
+        chunk++;
+    }
+
+    // Never overwrite the only copy of a chunk
+    while (IsSlotLive(s_head))
+    {
+        s_head = ((s_head + 1) % JOURNAL_SLOTS);
+    }
+
+    s_dirty &= ~(1UL << chunk);
+    s_record.sequence = s_sequence++;
+    s_record.chunk = chunk;
+    memcpy(s_record.data, &s_image[chunk * JOURNAL_CHUNK_BYTES], JOURNAL_CHUNK_BYTES);
+    s_record.crc = RecordCRC(s_record);
+    s_record_index = 0;
+    s_writing = true;
+    return true;
+}
+
+
+// Rebuild image from the newest valid record of each chunk
+// Returns false if the journal holds no records
+bool JournalInitialize(void)
+{
+    uint16_t sequence[JOURNAL_CHUNKS];
+    uint16_t newest = 0;
+    bool found = false;
+
+    memset(s_image, 0xFF, sizeof(s_image)); // Chunks without a record read as erased
+    memset(s_location, JOURNAL_EMPTY, sizeof(s_location));
+
+    for (uint8_t slot = 0; slot < JOURNAL_SLOTS; slot++)
+    {
+        const uint8_t* address = (const uint8_t*)(uintptr_t)(slot * JOURNAL_RECORD_BYTES);
+        JournalRecordStruct record;
+
+        // Erased and foreign slots are rejected on the chunk byte alone
+        if (eeprom_read_byte(address + offsetof(JournalRecordStruct, chunk)) >= JOURNAL_CHUNKS)
+        {
+            continue;
+        }
+
+        eeprom_read_block((void*)&record, (const void*)address, JOURNAL_RECORD_BYTES);
+
+        if ((record.chunk >= JOURNAL_CHUNKS) || (record.crc != RecordCRC(record)))
+        {
+            continue;
+        }
+
+        if ((s_location[record.chunk] != JOURNAL_EMPTY)
+            && ((int16_t)(record.sequence - sequence[record.chunk]) < 0))
+        {
+            continue; // Superseded
+        }
+
+        s_location[record.chunk] = slot;
+        sequence[record.chunk] = record.sequence;
+        memcpy(&s_image[record.chunk * JOURNAL_CHUNK_BYTES], record.data, JOURNAL_CHUNK_BYTES);
+
+        if (!found || ((int16_t)(record.sequence - newest) > 0))
+        {
+            newest = record.sequence;
+            s_head = slot;
+            found = true;
+        }
+    }
+
+    if (found)
+    {
+        s_sequence = (newest + 1);
+        s_head = ((s_head + 1) % JOURNAL_SLOTS);
+
+        // A refresh lost to a power cycle is made up here
+        for (uint8_t chunk = 0; chunk < JOURNAL_CHUNKS; chunk++)
+        {
+            if ((s_location[chunk] != JOURNAL_EMPTY)
+                && ((uint16_t)(newest - sequence[chunk]) >= (JOURNAL_REFRESH * JOURNAL_CHUNKS)))
+            {
+                s_dirty |= (1UL << chunk);
+                EECR |= _BV(EERIE);
+            }
+        }
+    }
+
+    return found;
+}
+
+
+void JournalRead(const uint8_t offset, void* destination, const uint8_t size)
+{
+    uint8_t limit = JOURNAL_IMAGE_BYTES - offset;
+    memcpy(destination, &s_image[offset], (size < limit) ? size : limit);
+}
+
+
+// Queue changed chunks - written in background by EE_READY interrupt
+// Offset is chunk aligned - returns true if any chunk changed
+bool JournalWrite(const uint8_t offset, const void* source, const uint8_t size)
+{
+    const uint8_t* data = static_cast<const uint8_t*>(source);
+    bool changed = false;
+    uint8_t limit = JOURNAL_IMAGE_BYTES - offset;
+    limit = (size < limit) ? size : limit;
+
+    for (uint8_t index = 0; index < limit; index += JOURNAL_CHUNK_BYTES)
+    {
+        uint8_t length = ((limit - index) < JOURNAL_CHUNK_BYTES) ? (limit - index) : JOURNAL_CHUNK_BYTES;
+        uint8_t* image = &s_image[offset + index];
+
+        if (memcmp(image, &data[index], length))
+        {
+            cli();
+            memcpy(image, &data[index], length);
+            s_dirty |= (1UL << ((offset + index) / JOURNAL_CHUNK_BYTES));
+            sei();
+            changed = true;
+        }
+    }
+
+    cli();
+
+    if (s_dirty)
+    {
+        EECR |= _BV(EERIE);
+    }
+
+    sei();
+    return changed;
+}
+
+
+bool JournalIsIdle(void)
+{
+    return !(EECR & _BV(EERIE));
+}
+
+
+void GetJournalStatistics(JournalStatisticsStruct& statistics)
+{
+    cli();
+    statistics = s_statistics;
+    sei();
+}
+
+
+// Programs one changed byte per interrupt (~3.4ms each)
+ISR(EE_READY_vect)
+{
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(&s_record);
+
+    while (true)
+    {
+        while (s_record_index < JOURNAL_RECORD_BYTES)
+        {
+            uint8_t value = data[s_record_index];
+            EEAR = ((s_head * JOURNAL_RECORD_BYTES) + s_record_index++);
+            EECR |= _BV(EERE);
+
+            if (EEDR != value)
+            {
+                EEDR = value;
+                EECR |= _BV(EEMPE);
+                EECR |= _BV(EEPE); // Erase and write
+                s_statistics.bytes++;
+                return;
+            }
+        }
+
+        if (s_writing)
+        {
+            // Last byte programmed - record supersedes previous copy
+            s_location[s_record.chunk] = s_head;
+            s_head = ((s_head + 1) % JOURNAL_SLOTS);
+            s_writing = false;
+            s_statistics.records++;
+        }
+
+        if (!BeginRecord())
+        {
+            EECR &= ~_BV(EERIE);
+            return;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Journal.h
+ * @summary     Wear-levelled EEPROM journal for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _JOURNAL_H
+#define _JOURNAL_H
+
+#include "B7971-Nixie-Clock.h"
+
+// Image is journalled in fixed size chunks, one record per changed chunk
+const uint8_t JOURNAL_CHUNK_BYTES = 4;
+const uint8_t JOURNAL_CHUNKS = 32;
+const uint8_t JOURNAL_IMAGE_BYTES = (JOURNAL_CHUNKS * JOURNAL_CHUNK_BYTES);
+const uint8_t JOURNAL_RECORD_BYTES = 8;
+const uint8_t JOURNAL_SLOTS = ((E2END + 1) / JOURNAL_RECORD_BYTES);
+const uint8_t JOURNAL_EMPTY = 0xFF; // No record for chunk
+const uint16_t JOURNAL_REFRESH = 512; // Records between rewrites of an unchanged chunk
+
+// Image regions are chunk aligned, so each owner dirties only its own chunks
+const uint8_t JOURNAL_RESET_BYTES = 16;
+const uint8_t JOURNAL_CONFIG_OFFSET = 0;
+const uint8_t JOURNAL_CONFIG_BYTES = (JOURNAL_IMAGE_BYTES - JOURNAL_RESET_BYTES);
+const uint8_t JOURNAL_RESET_OFFSET = JOURNAL_CONFIG_BYTES;
+
+struct JournalStatisticsStruct
+{
+    JournalStatisticsStruct()
+    : records(0)
+    , bytes(0)
+    {
+        // empty
+    }
+
+    uint32_t records;   // Records committed
+    uint32_t bytes;     // EEPROM cells programmed
+};
+
+bool JournalInitialize(void);
+void JournalRead(const uint8_t offset, void* destination, const uint8_t size);
+bool JournalWrite(const uint8_t offset, const void* source, const uint8_t size);
+bool JournalIsIdle(void);
+void GetJournalStatistics(JournalStatisticsStruct& statistics);
+
+#endif
@@ -26,6 +26,10 @@
  */
 
 #include "Menu.h"
+#include "Timer.h"
+#include "Format.h"
+#include "Diagnostics.h"
+#include "Supervisor.h"
 
 extern StateStruct g_state;         // struct
 extern Config g_config;             // struct
@@ -34,173 +38,488 @@ extern CDisplay g_display;          // class
 extern CAudio g_audio;              // class
 extern CNcoder g_encoder;           // class
 extern uint8_t g_song_entries;      // integral
+extern int16_t g_temperature;       // integral
 extern bool IsInputIncrement(void); // Function
 extern bool IsInputSelect(void);    // Function
 extern bool IsInputUpdate(void);    // Function
 
 
+// Press to step through pages, hold on entry to blank the display
 void MenuInfo(void)
 {
-    uint8_t function = 0;
-    uint32_t timeout = Timeout::INFO;
+    SupervisorResetStruct log[SUPERVISOR_LOG_ENTRIES];
+    const uint8_t resets = GetResetLog(log); // Newest first, after the revision
+    const uint8_t function_count = (4 + resets + DIAGNOSTICS_PAGES); // Reset prompt is last
+    InputEventStruct event;
+    char s[DISPLAY_COUNT + 1];
 
-    while (IsInputSelect() && --timeout);
+    if (!InputWaitRelease())
+    {
+        DisplayState(State::DISABLE);
+        return;
+    }
 
-    if (timeout)
+    for (uint8_t function = 0; function < function_count; function++)
     {
         do
         {
-            timeout = Timeout::INFO;
-            while (!IsInputSelect() && --timeout);
-            g_display.SetUnitIndicator(2, false);
-            
-            if (!timeout)
+            if (!InputWait(event, INPUT_INFO_TIMEOUT))
             {
-                break;
+                g_display.SetUnitIndicator(2, false);
+                return;
             }
-            
-            switch (function)
+        } while (event.type != InputType::PRESS);
+
+        g_display.SetUnitIndicator(2, false);
+
+        switch (function)
+        {
+        case 0:
+            FormatTemperature(s, g_temperature, g_config.temperature_unit); // Background sample
+            g_display.SetDisplayValue(s);
+            g_display.SetUnitIndicator(2, true);
+            break;
+        case 1:
+            g_display.SetDisplayValue((100 * (ReadBatteryMillivolts() - BATTERY_MIN)) / (BATTERY_MAX - BATTERY_MIN)); // Display percentage
+            g_display.SetUnitValue(0, 'B');
+            g_display.SetUnitValue(1, 'a');
+            g_display.SetUnitValue(2, 't');
+            break;
+        case 2:
+            g_display.SetDisplayValue(F("Rev   "));
+            g_display.SetUnitValue(4, '@' + VERSION);
+            break;
+        default:
+            if (function < (3 + resets))
             {
-            case 0:
-                float f_value;
-                f_value = g_rtc.GetTemperature(); // Get temperature in Celsius
+                FormatResetLog(s, log[function - 3]);
+                g_display.SetDisplayValue(s);
+                break;
+            }
 
-                if (g_config.temperature_unit == CRTC::Unit::F)
+            #ifdef DIAGNOSTICS
+                if (function < (function_count - 1))
                 {
-                    f_value = g_rtc.ConvertTemperature(g_rtc.GetTemperature(), CRTC::Unit::C, CRTC::Unit::F);
+                    FormatDiagnostics(s, function - 3 - resets);
+                    g_display.SetDisplayValue(s);
+                    break;
                 }
+            #endif
 
-                g_display.SetDisplayValue(f_value * 1000);
-                g_display.SetUnitValue(4, '`');
-                g_display.SetUnitValue(5, 'F');
-                g_display.SetUnitIndicator(2, true);
-                break;
-            case 1:
-                g_display.SetDisplayValue((100 * (ReadBatteryMillivolts() - BATTERY_MIN)) / (BATTERY_MAX - BATTERY_MIN)); // Display percentage
-                g_display.SetUnitValue(0, 'B');
-                g_display.SetUnitValue(1, 'a');
-                g_display.SetUnitValue(2, 't');
-                break;
-            case 2:
-                g_display.SetDisplayValue(F("Rev   "));
-                g_display.SetUnitValue(4, '@' + VERSION);
-                break;
-            case 3:
-                RestoreOutOfBox();
-                break;
-            }
+            RestoreOutOfBox();
+            break;
+        }
 
-            function++;
-            timeout = Timeout::INFO;
-            while (IsInputSelect() && --timeout); // Wait until release
-            
-            if (!timeout)
-            {
-                g_display.SetUnitIndicator(2, false);
-                Detonate();
-            }
+        if (!InputWaitRelease()) // Held on a page
+        {
+            g_display.SetUnitIndicator(2, false);
+            Detonate();
+            return;
         }
-        while ((function < 4) && timeout);
-    }
-    else
-    {
-        DisplayState(State::DISABLE);
     }
 }
 
 
-void MenuSettings(void)
+// Hotkey view of running countdowns, the stopwatch and its laps
+// Rotate to step through entries, click to capture a lap or exit
+// and hold to stop the stopwatch
+void MenuTimer(void)
 {
-    // Use full brightness for Menu
-    VoltageState(State::ENABLE);
-    g_display.SetDisplayBrightness(CDisplay::Brightness::MAX);
-    
-    CDisplay::PromptSelectStruct prompt_select;
-    prompt_select.item_count = MENU_ITEM_COUNT;
-    prompt_select.initial_selection = MENU_ITEM_ALARM;
-    prompt_select.display_mode = CDisplay::Mode::SCROLL;
+    const uint8_t view_count = (TIMER_COUNT + 1 + TIMER_LAPS);
+    const uint8_t view_stopwatch = TIMER_COUNT;
+    char s[DISPLAY_COUNT + 1];
+    uint8_t view = view_count - 1;
+    uint8_t shown = view_count; // Entry whose label was shown
+    uint16_t label = 0; // Time the label was shown
+    uint16_t active = millis(); // Time of last input
+    bool next = true; // Advance to first entry in use
+    bool captured = false; // Label the lap just captured
 
-    // Copy item table to local variable
-    char* array[sizeof(menu_item_array) / sizeof(char*)];
-    memcpy_P(array, menu_item_array, sizeof(array));
-    prompt_select.item_array = reinterpret_cast<type_const_char_ptr*>(array);
-    int8_t selection = g_display.PromptSelect(prompt_select, Timeout::MENU);
-    
-    if (selection > -1)
+    InputWaitRelease(); // Hotkey press does not count as a click
+    InputFlush();
+
+    while ((uint16_t)(millis() - active) < INPUT_VIEW_TIMEOUT)
     {
-        switch (selection)
-        {
-        default:
-        case MENU_ITEM_ALARM:
+        InputEventStruct event;
+        StopwatchStruct stopwatch;
+        GetStopwatch(stopwatch);
+
+        if (InputWait(event, 10))
         {
-            uint8_t alarm = 0; // Track selection
-            
-            if (SetAlarmState(alarm))
+            active = event.time;
+
+            if ((event.type == InputType::INCREMENT) || (event.type == InputType::DECREMENT))
             {
-                if (SetAlarmTime(alarm))
+                next = (event.type == InputType::INCREMENT);
+            }
+            else if ((view == view_stopwatch) && (stopwatch.state == StopwatchState::RUNNING))
+            {
+                if (event.type == InputType::CLICK)
+                {
+                    StopwatchLap();
+                    GetStopwatch(stopwatch);
+                    captured = true;
+                }
+                else if (event.type == InputType::LONG_PRESS)
                 {
-                    if (SetAlarmDays(alarm))
-                    {
-                        SetMusic(g_config.alarm[alarm].music);
-                    }
+                    StopwatchStop();
+                    GetStopwatch(stopwatch);
                 }
             }
-
-            break;
+            else if (event.type == InputType::CLICK)
+            {
+                break;
+            }
         }
-            
-        case MENU_ITEM_BRIGHTNESS:
-            if (SetBrightness() && (g_config.brightness == CDisplay::Brightness::AUTO))
+
+        if (next)
+        {
+            // Step to the adjacent entry in use
+            for (uint8_t step = 0; step < view_count; step++)
             {
-                if (SetGain())
+                view = (view + 1) % view_count;
+
+                if (((view < TIMER_COUNT) && GetTimerRemaining(view))
+                    || ((view == view_stopwatch) && (stopwatch.state != StopwatchState::RESET))
+                    || ((view > view_stopwatch) && ((view - view_stopwatch) <= stopwatch.lap_count)))
                 {
-                    SetOffset();
+                    break;
                 }
             }
-            break;
 
-        case MENU_ITEM_CONFIG:
-            if (SetTimeFormat())
+            next = false;
+        }
+
+        uint32_t value = (view < TIMER_COUNT) ? GetTimerRemaining(view)
+                       : (view == view_stopwatch) ? stopwatch.elapsed
+                       : stopwatch.lap[view - view_stopwatch - 1];
+
+        if ((view < TIMER_COUNT) && !value)
+        {
+            break; // Countdown expired or cancelled
+        }
+
+        if ((view != shown) || captured)
+        {
+            if (view < TIMER_COUNT)
             {
-                if (SetDateFormat())
-                {
-                    if (SetTemperatureUnit())
-                    {
-                        if (SetBlip())
-                        {
-                            if (SetBattery())
-                            {
-                                if (SetEffect())
-                                {
-                                    SetPhrase();
-                                }
-                            }
-                        }
-                    }
-                }
+                memcpy_P(s, PSTR("Tmr   "), DISPLAY_COUNT + 1);
+                s[4] = ('1' + view);
+            }
+            else if ((view == view_stopwatch) && !captured)
+            {
+                memcpy_P(s, PSTR("StopWt"), DISPLAY_COUNT + 1);
+            }
+            else
+            {
+                // Laps are kept newest first
+                uint8_t lap = (view == view_stopwatch) ? 0 : (view - view_stopwatch - 1);
+                memcpy_P(s, PSTR("Lap   "), DISPLAY_COUNT + 1);
+                FormatDecimal(&s[3], stopwatch.lap_count - lap, 3, ' ');
             }
-            break;
 
-        case MENU_ITEM_BLANK:
-            SetBlank();
-            break;
-            
-        case MENU_ITEM_TIME:
-            SetTime();
-            break;
+            captured = false;
+            g_display.SetDisplayIndicator(false);
+            g_display.SetDisplayValue(s);
+            shown = view;
+            label = millis();
+        }
+        else if ((uint16_t)(millis() - label) >= 500)
+        {
+            FormatTimer(value, s);
+            g_display.SetDisplayValue(s);
+            g_display.SetUnitIndicator(1, true);
+            g_display.SetUnitIndicator(3, true);
+        }
 
-        case MENU_ITEM_DATE:
-            SetDate();
-            break;
-            
-        case MENU_ITEM_MUSIC:
-            SetMusic(g_config.music_timer);
+    }
+
+    g_display.SetDisplayIndicator(false);
+}
+
+
+// Display labels and prompt titles - menu items come first
+enum MENU_LABEL : uint8_t
+{
+    MENU_LABEL_GAIN = MENU_ITEM_COUNT,
+    MENU_LABEL_OFFSET,
+    MENU_LABEL_HOUR,
+    MENU_LABEL_TEMP,
+    MENU_LABEL_NOISE,
+    MENU_LABEL_BATTERY,
+    MENU_LABEL_EFFECT,
+    MENU_LABEL_H24,
+    MENU_LABEL_H12,
+    MENU_LABEL_YMD,
+    MENU_LABEL_MDY,
+    MENU_LABEL_DMY,
+    MENU_LABEL_C,
+    MENU_LABEL_F,
+    MENU_LABEL_DISABLE,
+    MENU_LABEL_ENABLE,
+    MENU_LABEL_NONE,
+    MENU_LABEL_SPIRAL,
+    MENU_LABEL_DATE,
+    MENU_LABEL_PHRASE,
+    MENU_LABEL_TEMPERATURE,
+    MENU_LABEL_COUNT,
+};
+
+static const char menu_label[MENU_LABEL_COUNT][DISPLAY_COUNT + 1] PROGMEM =
+{
+    [MENU_ITEM_ALARM]       = "Alarm ",
+    [MENU_ITEM_BRIGHTNESS]  = "Bright",
+    [MENU_ITEM_CONFIG]      = "Config",
+    [MENU_ITEM_BLANK]       = "Dsplay",
+    [MENU_ITEM_TIME]        = " Time ",
+    [MENU_ITEM_DATE]        = " Date ",
+    [MENU_ITEM_MUSIC]       = "Audio ",
+    [MENU_ITEM_TIMER]       = "CountD",
+    [MENU_ITEM_STOPWATCH]   = "StopWt",
+    [MENU_LABEL_GAIN]       = " Gain ",
+    [MENU_LABEL_OFFSET]     = "Offset",
+    [MENU_LABEL_HOUR]       = " Hour ",
+    [MENU_LABEL_TEMP]       = " Temp ",
+    [MENU_LABEL_NOISE]      = "Noise ",
+    [MENU_LABEL_BATTERY]    = "Battry",
+    [MENU_LABEL_EFFECT]     = "Effect",
+    [MENU_LABEL_H24]        = "24 hr ",
+    [MENU_LABEL_H12]        = "12 hr ",
+    [MENU_LABEL_YMD]        = "Y-M-D ",
+    [MENU_LABEL_MDY]        = "M-D-Y ",
+    [MENU_LABEL_DMY]        = "D-M-Y ",
+    [MENU_LABEL_C]          = "Temp C",
+    [MENU_LABEL_F]          = "Temp F",
+    [MENU_LABEL_DISABLE]    = "Dsable",
+    [MENU_LABEL_ENABLE]     = "Enable",
+    [MENU_LABEL_NONE]       = " None ",
+    [MENU_LABEL_SPIRAL]     = "Spiral",
+    [MENU_LABEL_DATE]       = " Date ",
+    [MENU_LABEL_PHRASE]     = "Phrase",
+    [MENU_LABEL_TEMPERATURE] = " Temp ",
+};
+
+enum MENU_NODE : uint8_t
+{
+    MENU_NODE_ALARM,
+    MENU_NODE_BRIGHTNESS,
+    MENU_NODE_GAIN,
+    MENU_NODE_OFFSET,
+    MENU_NODE_TIME_FORMAT,
+    MENU_NODE_DATE_FORMAT,
+    MENU_NODE_TEMPERATURE,
+    MENU_NODE_NOISE,
+    MENU_NODE_BATTERY,
+    MENU_NODE_EFFECT,
+    MENU_NODE_PHRASE,
+    MENU_NODE_BLANK,
+    MENU_NODE_TIME,
+    MENU_NODE_DATE,
+    MENU_NODE_MUSIC,
+    MENU_NODE_TIMER,
+    MENU_NODE_STOPWATCH,
+    MENU_NODE_COUNT,
+};
+
+const uint8_t MENU_END = 0xFF; // No next node
+const uint8_t MENU_ANY = 0xFF; // Continue whatever the field holds
+
+enum class MenuType : uint8_t
+{
+    SELECT, // Enumerated config field chosen from labels
+    VALUE,  // Two digit config field within limits
+    ACTION, // Handler for settings spanning several prompts
+};
+
+struct MenuNodeStruct
+{
+    MenuType    type;
+    uint8_t     title;      // Label shown before the prompt
+    uint8_t     field;      // Offset of uint8_t sized field in Config
+    uint8_t     first;      // SELECT: first label, VALUE: lower limit
+    uint8_t     count;      // SELECT: label count, VALUE: upper limit
+    uint8_t     advance;    // Continue only while field holds this value
+    uint8_t     next;       // Node shown after this one is accepted
+    bool        (*action)(void); // ACTION: false stops the chain
+};
+
+constexpr MenuNodeStruct MenuSelect(const uint8_t field, const uint8_t title, const uint8_t first,
+                                    const uint8_t count, const uint8_t next)
+{
+    return {MenuType::SELECT, title, field, first, count, MENU_ANY, next, nullptr};
+}
+
+constexpr MenuNodeStruct MenuValue(const uint8_t field, const uint8_t title, const uint8_t lower,
+                                   const uint8_t upper, const uint8_t next)
+{
+    return {MenuType::VALUE, title, field, lower, upper, MENU_ANY, next, nullptr};
+}
+
+constexpr MenuNodeStruct MenuAction(bool (*action)(void), const uint8_t next = MENU_END,
+                                    const uint8_t field = 0, const uint8_t advance = MENU_ANY)
+{
+    return {MenuType::ACTION, 0, field, 0, 0, advance, next, action};
+}
+
+#define MENU_FIELD(member) offsetof(Config, member)
+
+static_assert(sizeof(Config::brightness) == 1 && sizeof(Config::gain) == 1
+              && sizeof(Config::offset) == 1 && sizeof(Config::time_format) == 1
+              && sizeof(Config::date_format) == 1 && sizeof(Config::temperature_unit) == 1
+              && sizeof(Config::noise) == 1 && sizeof(Config::battery) == 1
+              && sizeof(Config::effect) == 1, "Menu fields must be one byte");
+
+static const MenuNodeStruct menu_node[MENU_NODE_COUNT] PROGMEM =
+{
+    [MENU_NODE_ALARM]       = MenuAction(SetAlarm),
+    [MENU_NODE_BRIGHTNESS]  = MenuAction(SetBrightness, MENU_NODE_GAIN, MENU_FIELD(brightness),
+                                         getValue(CDisplay::Brightness::AUTO)),
+    [MENU_NODE_GAIN]        = MenuValue(MENU_FIELD(gain), MENU_LABEL_GAIN, 1, 50, MENU_NODE_OFFSET),
+    [MENU_NODE_OFFSET]      = MenuValue(MENU_FIELD(offset), MENU_LABEL_OFFSET, 0, 20, MENU_END),
+    [MENU_NODE_TIME_FORMAT] = MenuSelect(MENU_FIELD(time_format), MENU_LABEL_HOUR,
+                                         MENU_LABEL_H24, 2, MENU_NODE_DATE_FORMAT),
+    [MENU_NODE_DATE_FORMAT] = MenuSelect(MENU_FIELD(date_format), MENU_ITEM_DATE,
+                                         MENU_LABEL_YMD, 3, MENU_NODE_TEMPERATURE),
+    [MENU_NODE_TEMPERATURE] = MenuSelect(MENU_FIELD(temperature_unit), MENU_LABEL_TEMP,
+                                         MENU_LABEL_C, 2, MENU_NODE_NOISE),
+    [MENU_NODE_NOISE]       = MenuSelect(MENU_FIELD(noise), MENU_LABEL_NOISE,
+                                         MENU_LABEL_DISABLE, 2, MENU_NODE_BATTERY),
+    [MENU_NODE_BATTERY]     = MenuSelect(MENU_FIELD(battery), MENU_LABEL_BATTERY,
+                                         MENU_LABEL_DISABLE, 2, MENU_NODE_EFFECT),
+    [MENU_NODE_EFFECT]      = MenuSelect(MENU_FIELD(effect), MENU_LABEL_EFFECT,
+                                         MENU_LABEL_NONE, 5, MENU_NODE_PHRASE),
+    [MENU_NODE_PHRASE]      = MenuAction(SetPhrase),
+    [MENU_NODE_BLANK]       = MenuAction(SetBlank),
+    [MENU_NODE_TIME]        = MenuAction(SetTime),
+    [MENU_NODE_DATE]        = MenuAction(SetDate),
+    [MENU_NODE_MUSIC]       = MenuAction(SetTimerMusic),
+    [MENU_NODE_TIMER]       = MenuAction(SetTimer),
+    [MENU_NODE_STOPWATCH]   = MenuAction(SetStopwatch),
+};
+
+// First node of each menu item
+static const uint8_t menu_entry[MENU_ITEM_COUNT] PROGMEM =
+{
+    [MENU_ITEM_ALARM]       = MENU_NODE_ALARM,
+    [MENU_ITEM_BRIGHTNESS]  = MENU_NODE_BRIGHTNESS,
+    [MENU_ITEM_CONFIG]      = MENU_NODE_TIME_FORMAT,
+    [MENU_ITEM_BLANK]       = MENU_NODE_BLANK,
+    [MENU_ITEM_TIME]        = MENU_NODE_TIME,
+    [MENU_ITEM_DATE]        = MENU_NODE_DATE,
+    [MENU_ITEM_MUSIC]       = MENU_NODE_MUSIC,
+    [MENU_ITEM_TIMER]       = MENU_NODE_TIMER,
+    [MENU_ITEM_STOPWATCH]   = MENU_NODE_STOPWATCH,
+};
+
+
+static const __FlashStringHelper* MenuLabel(const uint8_t label)
+{
+    return reinterpret_cast<const __FlashStringHelper*>(menu_label[label]);
+}
+
+
+// Prompt for one of count consecutive labels
+static int8_t SelectLabel(CDisplay::PromptSelectStruct& prompt_select, const uint8_t first,
+                          const uint8_t count, const uint32_t timeout)
+{
+    const __FlashStringHelper* item_array[MENU_ITEM_COUNT]; // Menu is the longest list
+
+    for (uint8_t item = 0; item < count; item++)
+    {
+        item_array[item] = MenuLabel(first + item);
+    }
+
+    prompt_select.item_count = count;
+    prompt_select.item_array = reinterpret_cast<type_const_char_ptr*>(item_array);
+    return g_display.PromptSelect(prompt_select, timeout);
+}
+
+
+// Prompt for a node's config field - returns false if cancelled
+static bool MenuField(const MenuNodeStruct& node, uint8_t& field)
+{
+    if (node.type == MenuType::SELECT)
+    {
+        CDisplay::PromptSelectStruct prompt_select;
+        prompt_select.initial_selection = field;
+        prompt_select.title = MenuLabel(node.title);
+        int8_t selection = SelectLabel(prompt_select, node.first, node.count, Timeout::SELECT);
+
+        if (selection < 0)
+        {
+            return false;
+        }
+
+        field = selection;
+    }
+    else
+    {
+        char s[DISPLAY_COUNT + 1] = "      ";
+        CDisplay::PromptValueStruct prompt_value;
+        type_const_uint8 item_value[] = {field};
+        type_const_uint8 item_lower_limit[] = {node.first};
+        type_const_uint8 item_upper_limit[] = {node.count};
+        FormatDigits(&s[2], field);
+        prompt_value.item_count = 1;
+        prompt_value.item_position = (const uint8_t []){2};
+        prompt_value.item_digit_count = (const uint8_t []){2};
+        prompt_value.item_value = item_value;
+        prompt_value.item_lower_limit = item_lower_limit;
+        prompt_value.item_upper_limit = item_upper_limit;
+        prompt_value.initial_display = s;
+        prompt_value.title = MenuLabel(node.title);
+
+        if (SelectValue(prompt_value, InputCurve::GENTLE) < 0)
+        {
+            return false;
+        }
+
+        field = prompt_value.item_value[0];
+    }
+
+    SetConfig(g_config);
+    return true;
+}
+
+
+// Walk nodes from index until one is cancelled or the chain ends
+static void MenuRun(uint8_t index)
+{
+    while (index < MENU_NODE_COUNT)
+    {
+        MenuNodeStruct node;
+        memcpy_P(&node, &menu_node[index], sizeof(node));
+        uint8_t& field = reinterpret_cast<uint8_t*>(&g_config)[node.field];
+
+        if (!((node.type == MenuType::ACTION) ? node.action() : MenuField(node, field)))
+        {
             break;
+        }
 
-        case MENU_ITEM_TIMER:
-            SetTimer();
+        if ((node.advance != MENU_ANY) && (field != node.advance))
+        {
             break;
         }
+
+        index = node.next;
+    }
+}
+
+
+void MenuSettings(void)
+{
+    // Use full brightness for Menu
+    VoltageState(State::ENABLE);
+    g_display.SetDisplayBrightness(CDisplay::Brightness::MAX);
+    
+    CDisplay::PromptSelectStruct prompt_select;
+    prompt_select.initial_selection = MENU_ITEM_ALARM;
+    prompt_select.display_mode = CDisplay::Mode::SCROLL;
+    int8_t selection = SelectLabel(prompt_select, 0, MENU_ITEM_COUNT, Timeout::MENU);
+    
+    if (selection > -1)
+    {
+        MenuRun(pgm_read_byte(&menu_entry[selection]));
     }
 
     g_display.SetDisplayBrightness(g_config.brightness);
@@ -229,6 +548,16 @@ int8_t SelectState(CDisplay::PromptSelectStruct& prompt_select)
 }
 
 
+// PromptValue with encoder acceleration - fast spins step several values per detent
+int8_t SelectValue(CDisplay::PromptValueStruct& prompt_value, const InputCurve curve)
+{
+    InputSetCurve(curve);
+    int8_t result = g_display.PromptValue(prompt_value, Timeout::VALUE);
+    InputSetCurve(InputCurve::LINEAR);
+    return result;
+}
+
+
 bool SelectRTCValue(CDisplay::PromptValueStruct& prompt_value)
 {
     Cycle current_cycle = (prompt_value.item_value[0] < 12) ? Cycle::AM : Cycle::PM;
@@ -245,7 +574,7 @@ bool SelectRTCValue(CDisplay::PromptValueStruct& prompt_value)
         prompt_value.item_upper_limit = (const type_const_uint8 []){12, 59, 59};
     }
 
-    if (g_display.PromptValue(prompt_value, Timeout::VALUE) > -1)
+    if (SelectValue(prompt_value, InputCurve::GENTLE) > -1)
     {
         if (g_config.time_format == FormatTime::H12)
         {
@@ -309,7 +638,9 @@ bool SetBlank(void)
             minute = (g_config.blank_begin / 60) % 60;
         }
 
-        snprintf_P(s, DISPLAY_COUNT + 1, PSTR(" %02u%02u "), FormatHour(hour), minute);
+        memcpy_P(s, PSTR("      "), DISPLAY_COUNT + 1);
+        FormatDigits(&s[1], FormatHour(hour));
+        FormatDigits(&s[3], minute);
         type_const_uint8 item_value[] = {hour, minute};
         prompt_value.item_count = 2;
         prompt_value.item_position = (const uint8_t []){1, 3};
@@ -403,181 +734,6 @@ bool SetBrightness(void)
 }
 
 
-bool SetGain(void)
-{
-    char s[DISPLAY_COUNT + 1];
-    CDisplay::PromptValueStruct prompt_value;
-    snprintf_P(s, DISPLAY_COUNT + 1, PSTR("  %02u  "), g_config.gain);
-    type_const_uint8 item_value[] = {g_config.gain};
-    prompt_value.item_count = 1;
-    prompt_value.item_position = (const uint8_t []){2};
-    prompt_value.item_digit_count = (const uint8_t []){2};
-    prompt_value.item_value = item_value;
-    prompt_value.item_lower_limit = (const type_const_uint8 []){1};
-    prompt_value.item_upper_limit = (const type_const_uint8 []){50};
-    prompt_value.initial_display = s;
-    prompt_value.title = F(" Gain ");
-
-    if (g_display.PromptValue(prompt_value, Timeout::VALUE) > -1)
-    {
-        g_config.gain = prompt_value.item_value[0];
-        SetConfig(g_config);
-        return true;
-    }
-
-    return false;
-}
-
-
-bool SetOffset(void)
-{
-    char s[DISPLAY_COUNT + 1];
-    CDisplay::PromptValueStruct prompt_value;
-    snprintf_P(s, DISPLAY_COUNT + 1, PSTR("  %02u  "), g_config.offset);
-    type_const_uint8 item_value[] = {g_config.offset};
-    prompt_value.item_count = 1;
-    prompt_value.item_position = (const uint8_t []){2};
-    prompt_value.item_digit_count = (const uint8_t []){2};
-    prompt_value.item_value = item_value;
-    prompt_value.item_lower_limit = (const type_const_uint8 []){0};
-    prompt_value.item_upper_limit = (const type_const_uint8 []){20};
-    prompt_value.initial_display = s;
-    prompt_value.title = F("Offset");
-
-    if (g_display.PromptValue(prompt_value, Timeout::VALUE) > -1)
-    {
-        g_config.offset = prompt_value.item_value[0];
-        SetConfig(g_config);
-        return true;
-    }
-
-    return false;
-}
-
-
-bool SetEffect(void)
-{
-    CDisplay::PromptSelectStruct prompt_select;
-    prompt_select.item_count = 3;
-    prompt_select.initial_selection = getValue(g_config.effect);
-    prompt_select.title = F("Effect");
-    type_const_char_ptr item_array[] = {F(" None "), F("Spiral"), F(" Date "), F("Phrase")};
-    prompt_select.item_array = item_array;
-    int8_t selection = g_display.PromptSelect(prompt_select, Timeout::SELECT);
-
-    if (selection > -1)
-    {
-        g_config.effect = static_cast<decltype(g_config.effect)>(selection);
-        SetConfig(g_config);
-        return true;
-    }
-
-    return false;
-}
-
-
-bool SetBlip(void)
-{
-    CDisplay::PromptSelectStruct prompt_select;
-    prompt_select.initial_selection = getValue(g_config.noise);
-    prompt_select.title = F("Noise ");
-    int8_t selection = SelectState(prompt_select);
-
-    if (selection > -1)
-    {
-        g_config.noise = static_cast<decltype(g_config.noise)>(selection);
-        SetConfig(g_config);
-        return true;
-    }
-
-    return false;
-}
-
-
-bool SetBattery(void)
-{
-    CDisplay::PromptSelectStruct prompt_select;
-    prompt_select.item_count = 2;
-    prompt_select.initial_selection = getValue(g_config.battery);
-    prompt_select.title = F("Battry");
-    type_const_char_ptr item_array[] = {F("Dsable"), F("Enable")};
-    prompt_select.item_array = item_array;
-    int8_t selection = g_display.PromptSelect(prompt_select, Timeout::SELECT);
-
-    if (selection > -1)
-    {
-        g_config.battery = static_cast<decltype(g_config.battery)>(selection);
-        SetConfig(g_config);
-        return true;
-    }
-
-    return false;
-}
-
-
-bool SetTimeFormat(void)
-{
-    CDisplay::PromptSelectStruct prompt_select;
-    prompt_select.item_count = 2;
-    prompt_select.initial_selection = getValue(g_config.time_format);
-    prompt_select.title = F(" Hour ");
-    type_const_char_ptr item_array[] = {F("24 hr "), F("12 hr ")};
-    prompt_select.item_array = item_array;
-    int8_t selection = g_display.PromptSelect(prompt_select, Timeout::SELECT);
-
-    if (selection > -1)
-    {
-        g_config.time_format = static_cast<decltype(g_config.time_format)>(selection);
-        SetConfig(g_config);
-        return true;
-    }
-
-    return false;
-}
-
-
-bool SetDateFormat(void)
-{
-    CDisplay::PromptSelectStruct prompt_select;
-    prompt_select.item_count = 3;
-    prompt_select.initial_selection = getValue(g_config.date_format);
-    prompt_select.title = F(" Date ");
-    type_const_char_ptr item_array[] = {F("Y-M-D "), F("M-D-Y "), F("D-M-Y ")};
-    prompt_select.item_array = item_array;
-    int8_t selection = g_display.PromptSelect(prompt_select, Timeout::SELECT);
-
-    if (selection > -1)
-    {
-        g_config.date_format = static_cast<decltype(g_config.date_format)>(selection);
-        SetConfig(g_config);
-        return true;
-    }
-
-    return false;
-}
-
-
-bool SetTemperatureUnit(void)
-{
-    CDisplay::PromptSelectStruct prompt_select;
-    prompt_select.item_count = 2;
-    prompt_select.initial_selection = getValue(g_config.temperature_unit);
-    prompt_select.title = F(" Temp ");
-    type_const_char_ptr item_array[] = {F("Temp C"), F("Temp F")};
-    prompt_select.item_array = item_array;
-    int8_t selection = g_display.PromptSelect(prompt_select, Timeout::SELECT);
-
-    if (selection > -1)
-    {
-        g_config.temperature_unit = static_cast<decltype(g_config.temperature_unit)>(selection);
-        SetConfig(g_config);
-        return true;
-    }
-
-    return false;
-}
-
-
 bool SetTime(void)
 {
     char s[DISPLAY_COUNT + 1];
@@ -650,7 +806,7 @@ bool SetDate(void)
     prompt_value.initial_display = s;
     prompt_value.title = F(" Date ");
 
-    if (g_display.PromptValue(prompt_value, Timeout::VALUE) > -1)
+    if (SelectValue(prompt_value, InputCurve::GENTLE) > -1)
     {
         g_rtc.SetDate(prompt_value.item_value[item_value_index[0]],
                       prompt_value.item_value[item_value_index[1]],
@@ -663,50 +819,102 @@ bool SetDate(void)
 }
 
 
-bool SetAlarmState(uint8_t& alarm)
+// Remove an alarm, moving later alarms down to keep the list packed
+static void DeleteAlarm(const uint8_t alarm)
 {
-    type_const_char_ptr alarm_str[] = {F("A1 OFF"), F("A1 ON "),
-                                       F("A2 OFF"), F("A2 ON "),
-                                       F("A3 OFF"), F("A3 ON ")};
-    uint8_t alarm_index[ALARM_COUNT];
-    
-    for (uint8_t index = 0; index < ALARM_COUNT; index++)
+    for (uint8_t index = alarm; (index + 1) < g_config.alarm_count; index++)
     {
-        bool state = (g_config.alarm[index].state == State::ENABLE);
-        alarm_index[index] = (index * 2) + state;
+        g_config.alarm[index] = g_config.alarm[index + 1];
     }
-    
-    CDisplay::PromptSelectStruct prompt_select;
-    prompt_select.item_count = ALARM_COUNT;
-    prompt_select.display_mode = CDisplay::Mode::SCROLL;
-    
-    type_const_char_ptr item_array[ALARM_COUNT] = {alarm_str[alarm_index[0]],
-                                                   alarm_str[alarm_index[1]],
-                                                   alarm_str[alarm_index[2]]};
-    
-    prompt_select.item_array = item_array;
-    int8_t selection_alarm = g_display.PromptSelect(prompt_select, Timeout::SELECT);
 
-    if (selection_alarm > -1)
+    g_config.alarm_count--;
+    g_config.alarm[g_config.alarm_count] = AlarmStruct();
+    SetConfig(g_config);
+}
+
+
+// Alarm number, time, days and then music
+bool SetAlarm(void)
+{
+    uint8_t alarm = 0; // Track selection
+    const uint8_t count = g_config.alarm_count;
+
+    if (!(SetAlarmState(alarm) && SetAlarmTime(alarm) && SetAlarmDays(alarm)))
     {
-        prompt_select.initial_selection = getValue(g_config.alarm[selection_alarm].state);
-        int8_t selection_state = SelectState(prompt_select);
-        
+        // A new alarm is kept only once its time and days are set
+        if (g_config.alarm_count > count)
+        {
+            DeleteAlarm(alarm);
+        }
+
+        return false;
+    }
+
+    return SetMusic(g_config.alarm[alarm].music);
+}
+
+
+// Choose an alarm by number - one past the last starts a new alarm
+bool SetAlarmState(uint8_t& alarm)
+{
+    CDisplay::PromptValueStruct prompt_value;
+    uint8_t count = g_config.alarm_count;
+    uint8_t limit = (count < ALARM_MAX) ? (count + 1) : ALARM_MAX;
+
+    type_const_uint8 item_value[] = {1};
+    type_const_uint8 item_upper_limit[] = {limit};
+    prompt_value.item_count = 1;
+    prompt_value.item_position = (const uint8_t []){3};
+    prompt_value.item_digit_count = (const uint8_t []){2};
+    prompt_value.item_value = item_value;
+    prompt_value.item_lower_limit = (const type_const_uint8 []){1};
+    prompt_value.item_upper_limit = item_upper_limit;
+    prompt_value.initial_display = "  A01 ";
+    prompt_value.title = F("Alarm ");
+
+    if (g_display.PromptValue(prompt_value, Timeout::VALUE) > -1)
+    {
+        uint8_t selection_alarm = (prompt_value.item_value[0] - 1);
+        AlarmStruct& entry = g_config.alarm[selection_alarm];
+        CDisplay::PromptSelectStruct prompt_select;
+        prompt_select.initial_selection = ((entry.time & ALARM_ENABLE) != 0);
+        prompt_select.item_count = (selection_alarm < count) ? 3 : 2; // Only stored alarms are deleted
+        prompt_select.display_mode = CDisplay::Mode::STATIC;
+        type_const_char_ptr item_array[] = {F("Dsable"), F("Enable"), F("Delete")};
+        prompt_select.item_array = item_array;
+        int8_t selection_state = g_display.PromptSelect(prompt_select, Timeout::SELECT);
+
+        if (selection_state == 2)
+        {
+            DeleteAlarm(selection_alarm);
+            return false;
+        }
+
         if (selection_state > -1)
         {
+            if (selection_alarm == count)
+            {
+                if (!selection_state)
+                {
+                    return false; // Nothing to store for a disabled new alarm
+                }
+
+                g_config.alarm[count] = AlarmStruct(); // Append
+                g_config.alarm_count++;
+            }
+
             // Check if alarm is enabled
             if (selection_state)
             {
                 // Capture alarm selection
-                alarm = (uint8_t)selection_alarm;
+                alarm = selection_alarm;
                 // Set alarm if any days are enabled
-                g_config.alarm[alarm].state = (g_config.alarm[alarm].days == 0)
-                                            ? State::DISABLE : State::ENABLE;
+                entry.time = (entry.days == 0) ? (entry.time & ~ALARM_ENABLE) : (entry.time | ALARM_ENABLE);
             }
             else
             {
                 // Disable alarm
-                g_config.alarm[selection_alarm].state = static_cast<decltype(g_config.alarm[0].state)>(selection_state);
+                entry.time &= ~ALARM_ENABLE;
             }
 
             SetConfig(g_config);
@@ -725,10 +933,12 @@ bool SetAlarmTime(const uint8_t alarm)
     char s[DISPLAY_COUNT + 1];
     CDisplay::PromptValueStruct prompt_value;
 
-    uint8_t hour = g_config.alarm[alarm].time / 3600;
-    uint8_t minute = ((g_config.alarm[alarm].time / 60) % 60);
+    uint8_t hour = ((g_config.alarm[alarm].time & ALARM_MINUTE) / 60);
+    uint8_t minute = ((g_config.alarm[alarm].time & ALARM_MINUTE) % 60);
 
-    snprintf_P(s, DISPLAY_COUNT + 1, PSTR(" %02u%02u "), FormatHour(hour), minute);
+    memcpy_P(s, PSTR("      "), DISPLAY_COUNT + 1);
+    FormatDigits(&s[1], FormatHour(hour));
+    FormatDigits(&s[3], minute);
     type_const_uint8 item_value[] = {hour, minute};
     prompt_value.item_count = 2;
     prompt_value.item_position = (const uint8_t []){1, 3};
@@ -739,8 +949,9 @@ bool SetAlarmTime(const uint8_t alarm)
 
     if (SelectRTCValue(prompt_value))
     {
-        // Convert alarm to seconds
-        g_config.alarm[alarm].time = GetSeconds(prompt_value.item_value[0], prompt_value.item_value[1], 0);
+        // Convert alarm to minutes, keeping enable
+        g_config.alarm[alarm].time = ((g_config.alarm[alarm].time & ALARM_ENABLE)
+                                   | ((prompt_value.item_value[0] * 60U) + prompt_value.item_value[1]));
         SetConfig(g_config);
         return true;
     }
@@ -764,20 +975,21 @@ bool SetAlarmDays(const uint8_t alarm)
                                             F("Wdnsdy"), F("Thrsdy"), F("Friday"),
                                             F("Satrdy"), F("-Done-")};
         prompt_select.item_array = item_array;
-        g_encoder.SetRotation(CNcoder::Rotation::CCW); // Make display scroll from left
+        InputSetDirection(false); // Make display scroll from left
         selection = g_display.PromptSelect(prompt_select, Timeout::SELECT);
 
         if ((selection < 7) && (selection > -1))
         {
             CDisplay::PromptSelectStruct prompt_select_e;
-            prompt_select_e.initial_selection = ((g_config.alarm[alarm].days >> (selection + 1)) & 0x1);
+            prompt_select_e.initial_selection = ((g_config.alarm[alarm].days >> selection) & 0x1);
             int8_t state = SelectState(prompt_select_e);
 
             // Check if timeout
             if (state > -1)
             {
-                g_config.alarm[alarm].days ^= (-state ^ g_config.alarm[alarm].days) & (0x1 << (selection + 1));
-                g_config.alarm[alarm].state = (g_config.alarm[alarm].days == 0) ? State::DISABLE : State::ENABLE;
+                AlarmStruct& entry = g_config.alarm[alarm];
+                entry.days ^= (-state ^ entry.days) & (0x1 << selection);
+                entry.time = (entry.days == 0) ? (entry.time & ~ALARM_ENABLE) : (entry.time | ALARM_ENABLE);
                 SetConfig(g_config);
             }
             else
@@ -813,7 +1025,7 @@ bool SetPhrase(void)
     prompt_value.initial_display = s;
     prompt_value.title = F("Phrase");
 
-    if (g_display.PromptValue(prompt_value, Timeout::VALUE) > -1)
+    if (SelectValue(prompt_value, InputCurve::STEEP) > -1)
     {
         memcpy(g_config.phrase, prompt_value.item_value, DISPLAY_COUNT);
         SetConfig(g_config);
@@ -828,7 +1040,8 @@ bool SetMusic(uint8_t& music)
 {
     char s[DISPLAY_COUNT + 1];
     CDisplay::PromptValueStruct prompt_value;
-    snprintf_P(s, DISPLAY_COUNT + 1, PSTR("set %02u"), music);
+    memcpy_P(s, PSTR("set   "), DISPLAY_COUNT + 1);
+    FormatDigits(&s[4], music);
     type_const_uint8 item_value[] = {music};
     type_const_uint8 song_entries = g_song_entries - 1;
     type_const_uint8 item_upper_limit[] = {song_entries};
@@ -866,6 +1079,7 @@ bool SetMusic(uint8_t& music)
             //Don't time out during playback
             if (g_audio.IsActive())
             {
+                SupervisorCheckIn(SupervisorTask::MENU);
                 return true;
             }
 
@@ -885,7 +1099,13 @@ bool SetMusic(uint8_t& music)
 }
 
 
-void SetTimer(void)
+bool SetTimerMusic(void)
+{
+    return SetMusic(g_config.music_timer);
+}
+
+
+bool SetTimer(void)
 {
     uint32_t timer = 500;
     char s[DISPLAY_COUNT + 1];
@@ -894,7 +1114,7 @@ void SetTimer(void)
     uint8_t value1 = (timer / 100) % 100;
     uint8_t value2 = (timer % 100);
     type_const_uint8 item_value[] = {value0, value1, value2};
-    snprintf_P(s, DISPLAY_COUNT + 1, PSTR("%06lu"), timer);
+    FormatFields(s, value0, value1, value2);
     prompt_value.item_count = 3;
     prompt_value.item_position = (const uint8_t []){0, 2, 4};
     prompt_value.item_digit_count = (const uint8_t []){2, 2, 2};
@@ -904,10 +1124,52 @@ void SetTimer(void)
     prompt_value.initial_display = s;
     prompt_value.title = F(" Set  ");
 
-    if (g_display.PromptValue(prompt_value, Timeout::VALUE) > -1)
+    if (SelectValue(prompt_value, InputCurve::GENTLE) > -1)
+    {
+        // Runs in background - expiry plays music_timer from the main loop
+        uint32_t seconds = GetSeconds(prompt_value.item_value[0],
+                                      prompt_value.item_value[1],
+                                      prompt_value.item_value[2]);
+
+        if (!TimerStart(seconds * 1000))
+        {
+            g_display.SetDisplayValue(F(" Full "));
+            delay(1000);
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+
+bool SetStopwatch(void)
+{
+    StopwatchStruct stopwatch;
+    GetStopwatch(stopwatch);
+
+    CDisplay::PromptSelectStruct prompt_select;
+    prompt_select.item_count = 3;
+    prompt_select.initial_selection = (stopwatch.state == StopwatchState::RUNNING) ? 1 : 0;
+    prompt_select.display_mode = CDisplay::Mode::STATIC;
+    type_const_char_ptr item_array[] = {F("Start "), F(" Stop "), F("Reset ")};
+    prompt_select.item_array = item_array;
+
+    switch (g_display.PromptSelect(prompt_select, Timeout::SELECT))
     {
-        Timer(prompt_value.item_value[0],
-              prompt_value.item_value[1],
-              prompt_value.item_value[2]);
+    case 0:
+        StopwatchStart();
+        break;
+    case 1:
+        StopwatchStop();
+        break;
+    case 2:
+        StopwatchReset();
+        break;
+    default:
+        return false;
     }
+
+    return true;
 }
@@ -29,13 +29,13 @@
 #define _MENU_H
  
 #include "B7971-Nixie-Clock.h"
+#include "Input.h"
 
 typedef type_array type_const_char_ptr;
 typedef type_item type_const_uint8;
 
 enum Timeout : uint32_t
 {
-    INFO   = 200000,
     MENU   =    100,
     SELECT =    500,
     VALUE  =   5000,
@@ -51,53 +51,30 @@ enum MENU_ITEM : uint8_t
     MENU_ITEM_DATE,
     MENU_ITEM_MUSIC,
     MENU_ITEM_TIMER,
+    MENU_ITEM_STOPWATCH,
     MENU_ITEM_COUNT, // Number of menu items
 };
 
-static const char menu_item_ALARM[] PROGMEM         = "Alarm ";
-static const char menu_item_BRIGHTNESS[] PROGMEM    = "Bright";
-static const char menu_item_CONFIG[] PROGMEM        = "Config";
-static const char menu_item_BLANK[] PROGMEM         = "Dsplay";
-static const char menu_item_TIME[] PROGMEM          = " Time ";
-static const char menu_item_DATE[] PROGMEM          = " Date ";
-static const char menu_item_MUSIC[] PROGMEM         = "Audio ";
-static const char menu_item_TIMER[] PROGMEM         = "CountD";
-
-static PGM_P const menu_item_array[MENU_ITEM_COUNT] PROGMEM =
-{
-    [MENU_ITEM_ALARM] = menu_item_ALARM,
-    [MENU_ITEM_BRIGHTNESS] = menu_item_BRIGHTNESS,
-    [MENU_ITEM_CONFIG] = menu_item_CONFIG,
-    [MENU_ITEM_BLANK] = menu_item_BLANK,
-    [MENU_ITEM_TIME] = menu_item_TIME,
-    [MENU_ITEM_DATE] = menu_item_DATE,
-    [MENU_ITEM_MUSIC] = menu_item_MUSIC,
-    [MENU_ITEM_TIMER] = menu_item_TIMER,
-};
-
 void MenuInfo(void);
 void MenuSettings(void);
+void MenuTimer(void);
 int8_t SelectCycle(const Cycle init_value);
 int8_t SelectState(CDisplay::PromptSelectStruct& prompt_select);
+int8_t SelectValue(CDisplay::PromptValueStruct& prompt_value, const InputCurve curve);
 bool SelectRTCValue(CDisplay::PromptValueStruct& prompt_value);
 bool RestoreOutOfBox(void);
 bool SetBlank(void);
 bool SetBrightness(void);
-bool SetGain(void);
-bool SetOffset(void);
-bool SetTimeFormat(void);
-bool SetDateFormat(void);
-bool SetTemperatureUnit(void);
-bool SetEffect(void);
-bool SetBlip(void);
-bool SetBattery(void);
 bool SetTime(void);
 bool SetDate(void);
+bool SetAlarm(void);
 bool SetAlarmState(uint8_t& alarm);
 bool SetAlarmTime(const uint8_t alarm);
 bool SetAlarmDays(const uint8_t alarm);
 bool SetPhrase(void);
 bool SetMusic(uint8_t& music);
-void SetTimer(void);
+bool SetTimerMusic(void);
+bool SetTimer(void);
+bool SetStopwatch(void);
 
 #endif
@@ -32,7 +32,7 @@ extern CAudio g_audio;
 
 uint8_t* GetMusicDATA(const uint8_t index, const uint8_t channel)
 {
-    return pgm_read_word(&(music_list[index][channel]));
+    return static_cast<uint8_t*>(pgm_read_ptr(&(music_list[index][channel])));
 }
 
 
@@ -0,0 +1,430 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Protocol.cpp
+ * @summary     Framed serial protocol for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include <util/crc16.h>
+#include "Protocol.h"
+#include "Uart.h"
+#include "Adc.h"
+#include "Discipline.h"
+#include "Trace.h"
+
+extern Config g_config;             // struct
+extern CDS3232 g_rtc;               // class
+extern CDisplay g_display;          // class
+extern CAudio g_audio;              // class
+extern int16_t g_temperature;       // integral
+
+static_assert(sizeof(DisciplineStatusStruct) <= PROTOCOL_PAYLOAD, "Discipline payload");
+
+// Config member written byte by byte, each byte within limits
+struct ProtocolFieldStruct
+{
+    uint8_t offset;
+    uint8_t size;
+    uint8_t lower;
+    uint8_t upper;
+};
+
+#define PROTOCOL_FIELD(member, lower, upper) {offsetof(Config, member), sizeof(Config::member), lower, upper}
+
+static const ProtocolFieldStruct protocol_field[getValue(ProtocolField::COUNT)] PROGMEM =
+{
+    [getValue(ProtocolField::BRIGHTNESS)]       = PROTOCOL_FIELD(brightness, 0, getValue(CDisplay::Brightness::MAX)),
+    [getValue(ProtocolField::GAIN)]             = PROTOCOL_FIELD(gain, 1, 50),
+    [getValue(ProtocolField::OFFSET)]           = PROTOCOL_FIELD(offset, 0, 20),
+    [getValue(ProtocolField::TIME_FORMAT)]      = PROTOCOL_FIELD(time_format, 0, getValue(FormatTime::H12)),
+    [getValue(ProtocolField::DATE_FORMAT)]      = PROTOCOL_FIELD(date_format, 0, getValue(FormatDate::DDMMYY)),
+    [getValue(ProtocolField::TEMPERATURE_UNIT)] = PROTOCOL_FIELD(temperature_unit, 0, getValue(CRTC::Unit::F)),
+    [getValue(ProtocolField::NOISE)]            = PROTOCOL_FIELD(noise, 0, getValue(State::ENABLE)),
+    [getValue(ProtocolField::BATTERY)]          = PROTOCOL_FIELD(battery, 0, getValue(State::ENABLE)),
+    [getValue(ProtocolField::EFFECT)]           = PROTOCOL_FIELD(effect, 0, getValue(Effect::TEMPERATURE)),
+    [getValue(ProtocolField::MUSIC_TIMER)]      = PROTOCOL_FIELD(music_timer, 0, (INBUILT_SONG_COUNT - 1)),
+    [getValue(ProtocolField::PHRASE)]           = {offsetof(Config, phrase), DISPLAY_COUNT, 32, 127},
+};
+
+// Receiver state - bytes after SYNC are length, type, payload and CRC
+static uint8_t s_frame[PROTOCOL_PAYLOAD + 2];
+static uint8_t s_count = 0;
+static uint8_t s_crc = PROTOCOL_CRC_INIT;
+static bool s_sync = false;
+static uint16_t s_last = 0; // Arrival of last byte in frame
+static uint16_t s_stamp = 0; // Arrival of SYNC
+static uint16_t s_errors = 0;
+
+// Telemetry stream
+static uint8_t s_period = 0; // seconds, 0 when stopped
+static uint32_t s_report = 0; // millis() of last report
+static uint32_t s_loop_begin = 0;
+static uint32_t s_loop_max = 0;
+static uint16_t s_loops = 0;
+static uint16_t s_updates = 0; // Aging updates already reported
+
+
+static void Send(const uint8_t type, const uint8_t* payload, const uint8_t length)
+{
+    uint8_t frame[PROTOCOL_PAYLOAD + PROTOCOL_OVERHEAD];
+    uint8_t crc = PROTOCOL_CRC_INIT;
+
+    frame[0] = PROTOCOL_SYNC;
+    frame[1] = length;
+    frame[2] = type;
+    memcpy(&frame[3], payload, length);
+
+    for (uint8_t index = 1; index < (length + 3); index++)
+    {
+        crc = _crc8_ccitt_update(crc, frame[index]);
+    }
+
+    frame[length + 3] = crc;
+    UartWrite(frame, (length + PROTOCOL_OVERHEAD)); // Dropped if the host stops reading
+}
+
+
+static void Reply(const uint8_t type, const uint8_t* payload, const uint8_t length)
+{
+    Send((type | getValue(ProtocolType::REPLY)), payload, length);
+}
+
+
+static void Reject(const uint8_t type, const ProtocolError error)
+{
+    uint8_t payload[] = {type, getValue(error)};
+    Send(getValue(ProtocolType::NAK), payload, sizeof(payload));
+}
+
+
+static void ConfigRead(const uint8_t* payload, const uint8_t length)
+{
+    uint8_t type = getValue(ProtocolType::CONFIG_READ);
+    uint8_t reply[DISPLAY_COUNT + 1];
+    ProtocolFieldStruct field;
+
+    if (length != 1)
+    {
+        return Reject(type, ProtocolError::LENGTH);
+    }
+
+    if (payload[0] >= getValue(ProtocolField::COUNT))
+    {
+        return Reject(type, ProtocolError::FIELD);
+    }
+
+    memcpy_P(&field, &protocol_field[payload[0]], sizeof(field));
+    reply[0] = payload[0];
+    memcpy(&reply[1], (reinterpret_cast<const uint8_t*>(&g_config) + field.offset), field.size);
+    Reply(type, reply, (field.size + 1));
+}
+
+
+static void ConfigWrite(const uint8_t* payload, const uint8_t length)
+{
+    uint8_t type = getValue(ProtocolType::CONFIG_WRITE);
+    ProtocolFieldStruct field;
+
+    if (length < 1)
+    {
+        return Reject(type, ProtocolError::LENGTH);
+    }
+
+    if (payload[0] >= getValue(ProtocolField::COUNT))
+    {
+        return Reject(type, ProtocolError::FIELD);
+    }
+
+    memcpy_P(&field, &protocol_field[payload[0]], sizeof(field));
+
+    if (length != (field.size + 1))
+    {
+        return Reject(type, ProtocolError::LENGTH);
+    }
+
+    for (uint8_t index = 1; index < length; index++)
+    {
+        if ((payload[index] < field.lower) || (payload[index] > field.upper))
+        {
+            return Reject(type, ProtocolError::RANGE);
+        }
+    }
+
+    memcpy((reinterpret_cast<uint8_t*>(&g_config) + field.offset), &payload[1], field.size);
+
+    if (payload[0] == getValue(ProtocolField::BRIGHTNESS))
+    {
+        g_display.SetDisplayBrightness(g_config.brightness);
+    }
+
+    SetConfig(g_config); // Journaled in the background
+    Reply(type, payload, 1);
+}
+
+
+static void Execute(const uint8_t type, const uint8_t* payload, const uint8_t length)
+{
+    switch (static_cast<ProtocolType>(type))
+    {
+    case ProtocolType::PING:
+        Reply(type, &VERSION, 1);
+        return;
+    case ProtocolType::CONFIG_READ:
+        return ConfigRead(payload, length);
+    case ProtocolType::CONFIG_WRITE:
+        return ConfigWrite(payload, length);
+    case ProtocolType::TIME_SET:
+    case ProtocolType::DATE_SET:
+        if (length != 3)
+        {
+            return Reject(type, ProtocolError::LENGTH);
+        }
+
+        if (type == getValue(ProtocolType::TIME_SET))
+        {
+            if ((payload[0] > 23) || (payload[1] > 59) || (payload[2] > 59))
+            {
+                return Reject(type, ProtocolError::RANGE);
+            }
+
+            g_rtc.SetTime(payload[0], payload[1], payload[2]);
+        }
+        else
+        {
+            if ((payload[0] > 99) || (payload[1] < 1) || (payload[1] > 12) || (payload[2] < 1) || (payload[2] > 31))
+            {
+                return Reject(type, ProtocolError::RANGE);
+            }
+
+            g_rtc.SetDate(payload[0], payload[1], payload[2]);
+        }
+
+        ScheduleEvent(); // Alarms and blanking follow the new clock
+        break;
+    case ProtocolType::PLAY:
+        if (length != 1)
+        {
+            return Reject(type, ProtocolError::LENGTH);
+        }
+
+        if (payload[0] >= INBUILT_SONG_COUNT)
+        {
+            return Reject(type, ProtocolError::RANGE);
+        }
+
+        PlayMusic(payload[0]);
+        break;
+    case ProtocolType::STOP:
+        g_audio.Stop();
+        break;
+    case ProtocolType::TIME_SYNC:
+    {
+        if (length != 5)
+        {
+            return Reject(type, ProtocolError::LENGTH);
+        }
+
+        uint16_t milliseconds = (payload[3] | ((uint16_t)payload[4] << 8));
+
+        if ((payload[0] > 23) || (payload[1] > 59) || (payload[2] > 59) || (milliseconds > 999))
+        {
+            return Reject(type, ProtocolError::RANGE);
+        }
+
+        DisciplineReference(GetSeconds(payload[0], payload[1], payload[2]), milliseconds, s_stamp);
+        break;
+    }
+    case ProtocolType::DISCIPLINE_READ:
+    {
+        DisciplineStatusStruct status;
+        GetDisciplineStatus(status);
+        Reply(type, reinterpret_cast<const uint8_t*>(&status), sizeof(status));
+        return;
+    }
+    case ProtocolType::TRACE_READ:
+    {
+        uint8_t data[PROTOCOL_PAYLOAD];
+
+        if (length != 2)
+        {
+            return Reject(type, ProtocolError::LENGTH);
+        }
+
+        if ((payload[1] >= PROTOCOL_PAYLOAD) || (payload[0] >= TRACE_SRAM_BYTES)
+            || (payload[1] > (TRACE_SRAM_BYTES - payload[0])))
+        {
+            return Reject(type, ProtocolError::RANGE);
+        }
+
+        data[0] = payload[0];
+
+        if (!TraceRead(payload[0], &data[1], payload[1]))
+        {
+            return Reject(type, ProtocolError::BUS);
+        }
+
+        Reply(type, data, (payload[1] + 1));
+        return;
+    }
+    case ProtocolType::TELEMETRY_RATE:
+        if (length != 1)
+        {
+            return Reject(type, ProtocolError::LENGTH);
+        }
+
+        s_period = payload[0];
+        s_report = (millis() - (s_period * 1000UL)); // First report on next update
+        break;
+    default:
+        return Reject(type, ProtocolError::TYPE);
+    }
+
+    Reply(type, nullptr, 0);
+}
+
+
+// Bytes outside frames are offered to the NMEA parser
+static void Receive(const uint8_t data, const uint16_t stamp)
+{
+    // Gap before this byte - the host abandoned the frame
+    if (s_sync && ((uint16_t)(stamp - s_last) > PROTOCOL_TIMEOUT))
+    {
+        s_sync = false;
+        s_errors++;
+    }
+
+    if (!s_sync)
+    {
+        if (data == PROTOCOL_SYNC)
+        {
+            s_sync = true;
+            s_count = 0;
+            s_crc = PROTOCOL_CRC_INIT;
+            s_last = stamp;
+            s_stamp = stamp;
+        }
+        else
+        {
+            DisciplineNmea(data, stamp);
+        }
+
+        return;
+    }
+
+    s_last = stamp;
+
+    if ((s_count < 2) || (s_count < (s_frame[0] + 2)))
+    {
+        if ((s_count == 0) && (data > PROTOCOL_PAYLOAD))
+        {
+            s_sync = false; // Not a frame - hunt for the next SYNC
+            s_errors++;
+            return;
+        }
+
+        s_frame[s_count++] = data;
+        s_crc = _crc8_ccitt_update(s_crc, data);
+        return;
+    }
+
+    s_sync = false;
+
+    if (data != s_crc)
+    {
+        s_errors++;
+        return;
+    }
+
+    Execute(s_frame[1], &s_frame[2], s_frame[0]);
+}
+
+
+static void Report(void)
+{
+    ProtocolTelemetryStruct telemetry;
+
+    telemetry.uptime = (millis() / 1000);
+    telemetry.light = GetAdcValue(AdcChannel::LIGHT);
+    telemetry.battery = ReadBatteryMillivolts();
+    telemetry.temperature = g_temperature;
+    telemetry.loops = s_loops;
+    telemetry.loop_max = s_loop_max;
+    telemetry.errors = s_errors;
+    Send(getValue(ProtocolType::TELEMETRY), reinterpret_cast<const uint8_t*>(&telemetry), sizeof(telemetry));
+
+    s_loops = 0;
+    s_loop_max = 0;
+}
+
+
+// Called at the start of each loop iteration and after menus
+void ProtocolLoopBegin(void)
+{
+    s_loop_begin = micros();
+}
+
+
+// Called once per loop iteration before sleeping
+void ProtocolUpdate(void)
+{
+    uint32_t awake = (micros() - s_loop_begin);
+    uint8_t data;
+    uint16_t stamp;
+    DisciplineStatusStruct status;
+
+    s_loop_max = (awake > s_loop_max) ? awake : s_loop_max;
+    s_loops += (s_loops < UINT16_MAX);
+
+    while (UartRead(data, stamp))
+    {
+        Receive(data, stamp);
+    }
+
+    // Partial frame abandoned by the host - checked once the queue is empty
+    if (s_sync && ((uint16_t)((uint16_t)millis() - s_last) > PROTOCOL_TIMEOUT))
+    {
+        s_sync = false;
+        s_errors++;
+    }
+
+    GetDisciplineStatus(status);
+
+    if (status.updates != s_updates)
+    {
+        s_updates = status.updates;
+        Send(getValue(ProtocolType::DISCIPLINE), reinterpret_cast<const uint8_t*>(&status), sizeof(status));
+    }
+
+    if (s_period && ((millis() - s_report) >= (s_period * 1000UL)))
+    {
+        s_report = millis();
+        Report();
+    }
+}
+
+
+// USART and Timer0 halt in power-down
+bool ProtocolIsIdle(void)
+{
+    return (!s_sync && !s_period && UartIsIdle());
+}
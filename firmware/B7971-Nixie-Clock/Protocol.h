@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Protocol.h
+ * @summary     Framed serial protocol for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _PROTOCOL_H
+#define _PROTOCOL_H
+
+#include "B7971-Nixie-Clock.h"
+
+// Frame: SYNC, payload length, type, payload, CRC-8 of length through payload
+// Multi-byte values are little-endian
+const uint8_t PROTOCOL_SYNC = 0xB7;
+const uint8_t PROTOCOL_PAYLOAD = 20; // Largest payload in bytes
+const uint8_t PROTOCOL_OVERHEAD = 4; // Sync, length, type and CRC
+const uint8_t PROTOCOL_CRC_INIT = 0xFF;
+const uint8_t PROTOCOL_TIMEOUT = 50; // Milliseconds between bytes of one frame
+
+enum class ProtocolType : uint8_t
+{
+    PING = 0x01,            // -> [VERSION]
+    CONFIG_READ = 0x02,     // [field] -> [field, value...]
+    CONFIG_WRITE = 0x03,    // [field, value...] -> [field]
+    TIME_SET = 0x04,        // [hour, minute, second]
+    DATE_SET = 0x05,        // [year, month, day]
+    PLAY = 0x06,            // [song]
+    STOP = 0x07,
+    TELEMETRY_RATE = 0x08,  // [seconds] - 0 stops the stream
+    TIME_SYNC = 0x09,       // [hour, minute, second, milliseconds (2)] at the SYNC byte
+    DISCIPLINE_READ = 0x0A, // -> DisciplineStatusStruct
+    TRACE_READ = 0x0B,      // [offset, length] -> [offset, DS3232 SRAM...] - see Trace.h
+    TELEMETRY = 0x40,       // Unsolicited ProtocolTelemetryStruct
+    DISCIPLINE = 0x41,      // Unsolicited DisciplineStatusStruct after each aging update
+    NAK = 0x7F,             // [request type, ProtocolError]
+    REPLY = 0x80,           // Set on the type of each accepted request
+};
+
+enum class ProtocolError : uint8_t
+{
+    TYPE,       // Unknown request
+    LENGTH,     // Payload size does not match the request
+    FIELD,      // Unknown config field
+    RANGE,      // Value outside the field or calendar limits
+    BUS,        // DS3232 did not respond
+};
+
+// Config fields addressable by CONFIG_READ and CONFIG_WRITE - never renumbered
+enum class ProtocolField : uint8_t
+{
+    BRIGHTNESS,
+    GAIN,
+    OFFSET,
+    TIME_FORMAT,
+    DATE_FORMAT,
+    TEMPERATURE_UNIT,
+    NOISE,
+    BATTERY,
+    EFFECT,
+    MUSIC_TIMER,
+    PHRASE,         // DISPLAY_COUNT characters
+    COUNT,
+};
+
+struct ProtocolTelemetryStruct
+{
+    uint32_t    uptime;         // Seconds since reset
+    uint16_t    light;          // Filtered photodiode reading in ADC LSB
+    uint16_t    battery;        // millivolts
+    int16_t     temperature;    // Q8.2 Celsius
+    uint16_t    loops;          // Awake loop iterations since the last report
+    uint32_t    loop_max;       // Longest of those iterations in microseconds
+    uint16_t    errors;         // Frames discarded since reset
+} __attribute__((packed));
+
+static_assert(sizeof(ProtocolTelemetryStruct) <= PROTOCOL_PAYLOAD, "Telemetry payload");
+
+void ProtocolLoopBegin(void);
+void ProtocolUpdate(void);
+bool ProtocolIsIdle(void);
+
+#endif
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Supervisor.cpp
+ * @summary     Watchdog supervisor and reset log for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include "Supervisor.h"
+#include "Journal.h"
+#include "Trace.h"
+
+#ifdef HOST_BUILD
+#define SUPERVISOR_NOINIT
+#else
+#define SUPERVISOR_NOINIT __attribute__((section(".noinit")))
+#endif
+
+const uint8_t SUPERVISOR_TASKS = getValue(SupervisorTask::COUNT);
+
+// Survives a watchdog reset, garbage after power-on
+struct SupervisorCrashStruct
+{
+    uint8_t     task;   // SupervisorTask past its deadline
+    uint16_t    pc;     // Filled by WDT_vect
+    uint8_t     check;  // Tells a record from power-on contents
+};
+
+static_assert(sizeof(SupervisorResetStruct) == JOURNAL_CHUNK_BYTES, "Reset log entry size");
+static_assert((SUPERVISOR_LOG_ENTRIES * sizeof(SupervisorResetStruct)) == JOURNAL_RESET_BYTES, "Reset log size");
+static_assert(SUPERVISOR_TASKS <= 8, "Check-in register width");
+
+// Milliseconds an armed task may go without checking in
+static const uint16_t deadline[SUPERVISOR_TASKS] PROGMEM =
+{
+    2000,   // LOOP - waits are at most 50ms
+    250,    // DISPLAY - longest bit-plane is 16ms
+    5000,   // RTC - TICK_TIMEOUT poll and a retry
+    60000,  // MENU - longest prompt timeout is 50s
+};
+
+static SupervisorCrashStruct s_crash SUPERVISOR_NOINIT;
+static uint8_t s_mcusr SUPERVISOR_NOINIT;
+static uint16_t s_age[SUPERVISOR_TASKS]; // Milliseconds since check-in, saturating
+static uint8_t s_armed = 0;
+
+
+static uint8_t CrashCheck(const SupervisorCrashStruct& crash)
+{
+    return (crash.task ^ (crash.pc >> 8) ^ (crash.pc & 0xFF) ^ 0x5A);
+}
+
+
+static void SetCrash(const uint8_t task, const uint16_t pc)
+{
+    s_crash.task = task;
+    s_crash.pc = pc;
+    s_crash.check = CrashCheck(s_crash);
+}
+
+
+#ifndef HOST_BUILD
+// Runs before .bss is cleared - after a watchdog reset the watchdog
+// is left running at its shortest timeout. Optiboot clears MCUSR and
+// passes the flags it read in r2, which the startup code leaves alone.
+__attribute__((naked, used, section(".init3")))
+static void SupervisorBoot(void)
+{
+    uint8_t passed;
+
+    asm volatile("mov %0, r2" : "=r" (passed));
+
+    s_mcusr = MCUSR;
+
+    if (!s_mcusr)
+    {
+        s_mcusr = passed;
+    }
+
+    MCUSR = 0;
+    wdt_disable();
+}
+
+
+extern "C" __attribute__((noreturn, used)) void SupervisorCapture(const uint16_t pc)
+{
+    SetCrash(s_crash.task, (pc << 1)); // Byte address as listed by avr-objdump
+
+    while (true)
+    {
+        // Reset on next timeout
+    }
+}
+
+
+// Naked so the return address on top of the stack is the interrupted program counter
+ISR(WDT_vect, ISR_NAKED)
+{
+    asm volatile(
+        "pop r25"               "\n\t" // High byte on top
+        "pop r24"               "\n\t"
+        "clr __zero_reg__"      "\n\t"
+        "jmp SupervisorCapture" "\n\t"
+    );
+}
+#endif
+
+
+// Log the reset that started this run, then start the watchdog
+// Called once ConfigInitialize() has loaded the journal
+void SupervisorInitialize(void)
+{
+    #ifdef HOST_BUILD
+        s_mcusr = MCUSR; // No .init3 on the host
+        MCUSR = 0;
+    #endif
+
+    uint8_t task = SUPERVISOR_TASKS;
+    uint16_t pc = 0;
+
+    if ((s_mcusr & _BV(WDRF)) && (s_crash.check == CrashCheck(s_crash)))
+    {
+        task = s_crash.task;
+        pc = s_crash.pc;
+    }
+
+    TraceRecord(TraceType::RESET, s_mcusr, task); // Power cycles included
+
+    uint8_t cause = (s_mcusr & (_BV(WDRF) | _BV(BORF) | _BV(EXTRF)));
+
+    // Power cycles and resets with no flag to report are not logged
+    if (!(s_mcusr & _BV(PORF)) && cause)
+    {
+        SupervisorResetStruct log[SUPERVISOR_LOG_ENTRIES];
+
+        JournalRead(JOURNAL_RESET_OFFSET, log, sizeof(log));
+        memmove(&log[1], &log[0], sizeof(log) - sizeof(log[0]));
+        log[0].cause = cause;
+        log[0].task = task;
+        log[0].pc = pc;
+        JournalWrite(JOURNAL_RESET_OFFSET, log, sizeof(log));
+    }
+
+    SetCrash(SUPERVISOR_TASKS, 0);
+    s_armed = (_BV(getValue(SupervisorTask::LOOP)) | _BV(getValue(SupervisorTask::DISPLAY)));
+    SupervisorEnable();
+}
+
+
+// Interrupt and system reset mode - WDT_vect captures the program counter first
+void SupervisorEnable(void)
+{
+    wdt_enable(WDTO_1S);
+    WDTCSR |= _BV(WDIE);
+}
+
+
+// Arming an idle task restarts its deadline
+void SupervisorArm(const SupervisorTask task, const bool armed)
+{
+    uint8_t mask = _BV(getValue(task));
+
+    cli();
+
+    if (!armed)
+    {
+        s_armed &= ~mask;
+    }
+    else if (!(s_armed & mask))
+    {
+        s_age[getValue(task)] = 0;
+        s_armed |= mask;
+    }
+
+    sei();
+}
+
+
+// Called from Timer0 ISR - feeds the watchdog while every armed task is on time
+void SupervisorTick(void)
+{
+    uint8_t checked = GPIOR0;
+    uint8_t stalled = SUPERVISOR_TASKS;
+
+    GPIOR0 = 0;
+
+    for (uint8_t task = 0; task < SUPERVISOR_TASKS; task++)
+    {
+        if (checked & _BV(task))
+        {
+            s_age[task] = 0;
+        }
+        else if (s_age[task] != UINT16_MAX)
+        {
+            s_age[task]++;
+        }
+
+        if ((stalled == SUPERVISOR_TASKS) && (s_armed & _BV(task))
+            && (s_age[task] > pgm_read_word(&deadline[task])))
+        {
+            stalled = task;
+        }
+    }
+
+    if (stalled == SUPERVISOR_TASKS)
+    {
+        wdt_reset();
+    }
+
+    if (stalled != s_crash.task)
+    {
+        SetCrash(stalled, 0);
+    }
+}
+
+
+SupervisorTask SupervisorStalled(void)
+{
+    return static_cast<SupervisorTask>(s_crash.task);
+}
+
+
+// Returns the number of entries in use, newest first
+uint8_t GetResetLog(SupervisorResetStruct* log)
+{
+    uint8_t count = 0;
+
+    JournalRead(JOURNAL_RESET_OFFSET, log, JOURNAL_RESET_BYTES);
+
+    while ((count < SUPERVISOR_LOG_ENTRIES) && (log[count].cause != SUPERVISOR_EMPTY))
+    {
+        count++;
+    }
+
+    return count;
+}
+
+
+// Cause and task letters then the program counter in hex
+// "WL01A4" - watchdog reset, main loop stalled at 0x01A4
+void FormatResetLog(char* s, const SupervisorResetStruct& entry)
+{
+    static const char task_label[SUPERVISOR_TASKS + 1] PROGMEM = {'L', 'D', 'C', 'M', '-'};
+    uint8_t task = (entry.task < SUPERVISOR_TASKS) ? entry.task : SUPERVISOR_TASKS;
+
+    if (entry.cause & _BV(WDRF))
+    {
+        s[0] = 'W';
+    }
+    else if (entry.cause & _BV(BORF))
+    {
+        s[0] = 'B';
+    }
+    else if (entry.cause & _BV(EXTRF))
+    {
+        s[0] = 'E';
+    }
+    else
+    {
+        s[0] = 'J'; // Jump to the reset vector
+    }
+
+    s[1] = pgm_read_byte(&task_label[task]);
+
+    for (uint8_t index = 0; index < 4; index++)
+    {
+        uint8_t nibble = ((entry.pc >> (12 - (index * 4))) & 0xF);
+        s[2 + index] = (nibble < 10) ? ('0' + nibble) : ('A' + nibble - 10);
+    }
+
+    s[DISPLAY_COUNT] = '\0';
+}
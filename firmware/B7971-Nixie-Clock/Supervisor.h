@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Supervisor.h
+ * @summary     Watchdog supervisor and reset log for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _SUPERVISOR_H
+#define _SUPERVISOR_H
+
+#include "B7971-Nixie-Clock.h"
+
+const uint8_t SUPERVISOR_LOG_ENTRIES = 4; // Newest first, one journal chunk each
+const uint8_t SUPERVISOR_EMPTY = 0xFF; // Cause of an unused entry
+
+// Tasks check in by setting their bit in GPIOR0 - in I/O space below 0x20, so a single sbi in any context
+enum class SupervisorTask : uint8_t
+{
+    LOOP,       // Main loop iteration or a foreground poll
+    DISPLAY,    // Timer2 bit-plane refresh
+    RTC,        // New second read while the 1Hz tick is selected
+    MENU,       // User input while a menu is open
+    COUNT,      // No task stalled
+};
+
+struct SupervisorResetStruct
+{
+    uint8_t     cause;  // MCUSR flags, 0 after a jump to the reset vector
+    uint8_t     task;   // SupervisorTask that missed its deadline
+    uint16_t    pc;     // Byte address interrupted by the watchdog, 0 if unknown
+} __attribute__((packed));
+
+inline void SupervisorCheckIn(const SupervisorTask task)
+{
+    GPIOR0 |= _BV(getValue(task));
+}
+
+void SupervisorInitialize(void);
+void SupervisorEnable(void);
+void SupervisorArm(const SupervisorTask task, const bool armed);
+void SupervisorTick(void);
+SupervisorTask SupervisorStalled(void);
+uint8_t GetResetLog(SupervisorResetStruct* log);
+void FormatResetLog(char* s, const SupervisorResetStruct& entry);
+
+#endif
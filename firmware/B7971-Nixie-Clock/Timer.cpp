@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Timer.cpp
+ * @summary     Background countdown timers and stopwatch for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include "Timer.h"
+#include "Format.h"
+
+// Counted in milliseconds by the Timer0 interrupt, zero when idle
+static volatile uint32_t s_remaining[TIMER_COUNT];
+static volatile uint8_t s_expired = 0; // Bit per countdown awaiting acknowledge
+static uint16_t s_fraction = 0; // Microseconds past the last whole millisecond
+static StopwatchStruct s_stopwatch;
+
+
+// Called from Timer0 interrupt every TIMER_TICK_MICROS
+void TimerTick(void)
+{
+    uint8_t step = (TIMER_TICK_MICROS / 1000);
+
+    s_fraction += (TIMER_TICK_MICROS % 1000);
+
+    if (s_fraction >= 1000)
+    {
+        s_fraction -= 1000;
+        step++; // Every 41 or 42 ticks
+    }
+
+    for (uint8_t index = 0; index < TIMER_COUNT; index++)
+    {
+        if (s_remaining[index])
+        {
+            s_remaining[index] = ((s_remaining[index] > step) ? (s_remaining[index] - step) : 0);
+
+            if (!s_remaining[index])
+            {
+                s_expired |= _BV(index);
+            }
+        }
+    }
+
+    if (s_stopwatch.state == StopwatchState::RUNNING)
+    {
+        s_stopwatch.elapsed += step;
+
+        if (s_stopwatch.elapsed > TIMER_MAX)
+        {
+            s_stopwatch.elapsed = TIMER_MAX;
+        }
+    }
+}
+
+
+// Returns false if every countdown is in use
+bool TimerStart(const uint32_t milliseconds)
+{
+    if (!milliseconds)
+    {
+        return false;
+    }
+
+    for (uint8_t index = 0; index < TIMER_COUNT; index++)
+    {
+        cli();
+
+        if (!s_remaining[index])
+        {
+            s_remaining[index] = ((milliseconds > TIMER_MAX) ? TIMER_MAX : milliseconds);
+            sei();
+            return true;
+        }
+
+        sei();
+    }
+
+    return false;
+}
+
+
+void TimerCancel(const uint8_t index)
+{
+    cli();
+    s_remaining[index] = 0;
+    s_expired &= ~_BV(index);
+    sei();
+}
+
+
+uint32_t GetTimerRemaining(const uint8_t index)
+{
+    cli();
+    uint32_t remaining = s_remaining[index];
+    sei();
+    return remaining;
+}
+
+
+// Returns expired countdowns since last call
+uint8_t TimerAcknowledge(void)
+{
+    cli();
+    uint8_t expired = s_expired;
+    s_expired = 0;
+    sei();
+    return expired;
+}
+
+
+bool TimerIsExpired(void)
+{
+    return (s_expired != 0);
+}
+
+
+// Any countdown running or stopwatch holding a time
+bool TimerIsActive(void)
+{
+    return (!TimerIsIdle() || (s_stopwatch.state != StopwatchState::RESET));
+}
+
+
+// Timer0 halts in power-down - running timers keep the MCU in idle
+bool TimerIsIdle(void)
+{
+    for (uint8_t index = 0; index < TIMER_COUNT; index++)
+    {
+        if (GetTimerRemaining(index))
+        {
+            return false;
+        }
+    }
+
+    return (s_stopwatch.state != StopwatchState::RUNNING);
+}
+
+
+void StopwatchStart(void)
+{
+    s_stopwatch.state = StopwatchState::RUNNING;
+}
+
+
+void StopwatchStop(void)
+{
+    if (s_stopwatch.state == StopwatchState::RUNNING)
+    {
+        s_stopwatch.state = StopwatchState::STOPPED;
+    }
+}
+
+
+void StopwatchReset(void)
+{
+    cli();
+    s_stopwatch = StopwatchStruct();
+    sei();
+}
+
+
+// Capture elapsed time without stopping
+void StopwatchLap(void)
+{
+    cli();
+    memmove(&s_stopwatch.lap[1], &s_stopwatch.lap[0], sizeof(s_stopwatch.lap) - sizeof(s_stopwatch.lap[0]));
+    s_stopwatch.lap[0] = s_stopwatch.elapsed;
+
+    if (s_stopwatch.lap_count < UINT8_MAX)
+    {
+        s_stopwatch.lap_count++;
+    }
+
+    sei();
+}
+
+
+void GetStopwatch(StopwatchStruct& stopwatch)
+{
+    cli();
+    stopwatch = s_stopwatch;
+    sei();
+}
+
+
+// "MMSScc" below one hour, otherwise "HHMMSS"
+void FormatTimer(const uint32_t milliseconds, char* s)
+{
+    uint32_t seconds = (milliseconds / 1000);
+    uint8_t field[3];
+
+    if (seconds < 3600)
+    {
+        field[0] = (seconds / 60);
+        field[1] = (seconds % 60);
+        field[2] = ((milliseconds % 1000) / 10);
+    }
+    else
+    {
+        field[0] = (seconds / 3600);
+        field[1] = ((seconds / 60) % 60);
+        field[2] = (seconds % 60);
+    }
+
+    FormatFields(s, field[0], field[1], field[2]);
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Timer.h
+ * @summary     Background countdown timers and stopwatch for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _TIMER_H
+#define _TIMER_H
+
+#include "B7971-Nixie-Clock.h"
+
+const uint8_t TIMER_COUNT = 3;  // Concurrent countdowns
+const uint8_t TIMER_LAPS = 4;   // Newest laps kept
+const uint32_t TIMER_MAX = (24UL * 60 * 60 * 1000) - 1; // Milliseconds
+const uint16_t TIMER_TICK_MICROS = 1024; // Timer0 period - 16MHz / (64 prescaler * 256)
+
+enum class StopwatchState : uint8_t
+{
+    RESET,
+    RUNNING,
+    STOPPED,
+};
+
+struct StopwatchStruct
+{
+    StopwatchStruct()
+    : state(StopwatchState::RESET)
+    , elapsed(0)
+    , lap_count(0)
+    , lap()
+    {
+        // empty
+    }
+
+    StopwatchState  state;
+    uint32_t        elapsed;            // Milliseconds
+    uint8_t         lap_count;          // Laps captured since reset
+    uint32_t        lap[TIMER_LAPS];    // Elapsed at capture, newest first
+};
+
+void TimerTick(void);
+bool TimerStart(const uint32_t milliseconds);
+void TimerCancel(const uint8_t index);
+uint32_t GetTimerRemaining(const uint8_t index);
+uint8_t TimerAcknowledge(void);
+bool TimerIsExpired(void);
+bool TimerIsActive(void);
+bool TimerIsIdle(void);
+void StopwatchStart(void);
+void StopwatchStop(void);
+void StopwatchReset(void);
+void StopwatchLap(void);
+void GetStopwatch(StopwatchStruct& stopwatch);
+void FormatTimer(const uint32_t milliseconds, char* s);
+
+#endif
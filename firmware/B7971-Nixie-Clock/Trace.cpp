@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Trace.cpp
+ * @summary     Event trace in DS3232 SRAM for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include "Trace.h"
+
+extern CDS3232 g_rtc;               // class
+
+// Event awaiting a burst, timed once the clock has been read after it
+struct TraceEventStruct
+{
+    TraceType   type;
+    uint8_t     data[2];
+    uint8_t     generation; // s_generation when recorded
+    uint32_t    stamp;      // millis()
+};
+
+static TraceEventStruct s_queue[TRACE_QUEUE];
+static TraceEntryStruct s_burst[TRACE_QUEUE]; // Sent by the TWI interrupt, also used to search the ring
+static TwiTransactionStruct s_request;
+static TraceStatisticsStruct s_statistics;
+static uint8_t s_count = 0; // Queued events, the first s_flight are in s_burst
+static uint8_t s_flight = 0;
+static uint8_t s_head = 0; // Ring index of the next entry
+static uint8_t s_sequence = 0; // Sequence of the entry at s_head
+static bool s_ready = false; // Ring located
+static uint8_t s_attempt = 0; // s_generation when the ring was last searched
+
+// Clock at the last read
+static uint8_t s_generation = 0; // Clock reads
+static uint8_t s_day = 1;
+static uint16_t s_minute = 0;
+static uint8_t s_second = 0;
+static uint32_t s_read = 0; // millis() at the read
+
+
+// Continue after newest, which is stored before head
+static void Locate(const uint8_t head, const TraceEntryStruct& newest)
+{
+    s_head = head;
+    s_sequence = ((newest.tag + 1) & TRACE_SEQUENCE_MASK);
+    s_ready = true;
+}
+
+
+// Clear the ring and write the format byte
+static bool Format(void)
+{
+    uint8_t zero[4 * TRACE_ENTRY_BYTES] = {};
+    uint8_t magic = TRACE_MAGIC;
+
+    for (uint8_t offset = 0; offset < (TRACE_ENTRIES * TRACE_ENTRY_BYTES); offset += sizeof(zero))
+    {
+        uint8_t remaining = ((TRACE_ENTRIES * TRACE_ENTRY_BYTES) - offset);
+
+        if (!g_rtc.WriteRegister((TRACE_RING + offset), zero, (remaining < sizeof(zero)) ? remaining : sizeof(zero)))
+        {
+            return false;
+        }
+    }
+
+    return g_rtc.WriteRegister(DS3232_REGISTER_SRAM, &magic, 1);
+}
+
+
+// Locate the newest entry - the only one not followed by its successor
+// Blocking, reads the ring through the burst buffer
+void TraceInitialize(void)
+{
+    TraceEntryStruct first;
+    TraceEntryStruct entry;
+    uint8_t magic;
+
+    s_attempt = s_generation;
+
+    if (!g_rtc.ReadRegister(DS3232_REGISTER_SRAM, &magic, 1))
+    {
+        return; // Events stay queued until the queue fills
+    }
+
+    if (magic != TRACE_MAGIC)
+    {
+        s_ready = Format(); // Battery replaced or never used
+        return;
+    }
+
+    for (uint8_t index = 0; index < TRACE_ENTRIES; index += TRACE_QUEUE)
+    {
+        uint8_t count = ((TRACE_ENTRIES - index) < TRACE_QUEUE) ? (TRACE_ENTRIES - index) : TRACE_QUEUE;
+
+        if (!g_rtc.ReadRegister((TRACE_RING + (index * TRACE_ENTRY_BYTES)),
+                                reinterpret_cast<uint8_t*>(s_burst), (count * TRACE_ENTRY_BYTES)))
+        {
+            return;
+        }
+
+        for (uint8_t offset = 0; offset < count; offset++)
+        {
+            if ((index + offset) == 0)
+            {
+                first = s_burst[0];
+            }
+            else if (TraceIsEntry(entry) && !TraceFollows(entry, s_burst[offset]))
+            {
+                return Locate((index + offset), entry);
+            }
+
+            entry = s_burst[offset];
+        }
+    }
+
+    if (TraceIsEntry(entry) && !TraceFollows(entry, first))
+    {
+        return Locate(0, entry);
+    }
+
+    s_ready = true; // Empty ring starts at entry 0
+}
+
+
+// Consecutive CONFIG or BRIGHTNESS events awaiting the same burst are merged
+void TraceRecord(const TraceType type, const uint8_t data0, const uint8_t data1)
+{
+    TraceEventStruct* event = &s_queue[(s_count > s_flight) ? (s_count - 1) : 0];
+
+    if ((s_count > s_flight) && (event->type == type)
+        && ((type == TraceType::CONFIG) || (type == TraceType::BRIGHTNESS)))
+    {
+        event->data[0] = data0;
+
+        if (type == TraceType::CONFIG)
+        {
+            event->data[1] = data1; // BRIGHTNESS keeps the first previous level
+        }
+    }
+    else if (s_count < TRACE_QUEUE)
+    {
+        event = &s_queue[s_count++];
+        event->type = type;
+        event->data[0] = data0;
+        event->data[1] = data1;
+    }
+    else
+    {
+        s_statistics.dropped++;
+        return;
+    }
+
+    event->generation = s_generation;
+    event->stamp = millis();
+}
+
+
+// Called with each time read from the DS3232
+void TraceTick(const CRTC::RTC& rtc)
+{
+    s_generation++;
+    s_day = rtc.day;
+    s_minute = ((rtc.hour * 60) + rtc.minute);
+    s_second = rtc.second;
+    s_read = millis();
+}
+
+
+// True while queued events wait for the clock to be read
+bool TraceIsWaiting(void)
+{
+    return (s_ready && (s_count > s_flight) && (s_queue[s_count - 1].generation == s_generation));
+}
+
+
+bool TraceIsIdle(void)
+{
+    return (!s_ready || (s_count == 0));
+}
+
+
+static uint16_t EntryTime(const uint32_t stamp)
+{
+    int32_t elapsed = (int32_t)(stamp - s_read); // Negative for events before the read
+
+    // Read may follow the edge by up to a second - earlier stamps within it count as its second
+    if ((elapsed < 0) && (elapsed > -1000))
+    {
+        elapsed = 0;
+    }
+
+    elapsed += (s_second * 1000L); // From second 0 of s_minute
+    int16_t minute = (s_minute + ((elapsed - ((elapsed < 0) ? 59999 : 0)) / 60000));
+    uint8_t day = s_day;
+
+    if (minute < 0)
+    {
+        minute += TRACE_MINUTES;
+        day = (day > 1) ? (day - 1) : 31; // Length of the previous month is unknown
+    }
+    else if (minute >= (int16_t)TRACE_MINUTES)
+    {
+        minute -= TRACE_MINUTES;
+        day = (day < 31) ? (day + 1) : 1;
+    }
+
+    return ((uint16_t)(day - 1) << 11) | minute;
+}
+
+
+// Called from the main loop - writes queued events to the ring in one burst
+void TraceUpdate(void)
+{
+    if (s_request.status == TwiStatus::PENDING)
+    {
+        return;
+    }
+
+    if (s_flight)
+    {
+        // Failed bursts are repeated with the same sequence numbers
+        if (s_request.status == TwiStatus::COMPLETE)
+        {
+            s_head = ((s_head + s_flight) % TRACE_ENTRIES);
+            s_sequence = ((s_sequence + s_flight) & TRACE_SEQUENCE_MASK);
+            s_count -= s_flight;
+            memmove(&s_queue[0], &s_queue[s_flight], (s_count * sizeof(TraceEventStruct)));
+            s_statistics.recorded += s_flight;
+            s_statistics.bursts++;
+        }
+
+        s_request.status = TwiStatus::IDLE;
+        s_flight = 0;
+    }
+
+    if (!s_ready)
+    {
+        // Bus failed at startup - search again after a clock read succeeds
+        if (s_attempt != s_generation)
+        {
+            TraceInitialize();
+        }
+
+        return;
+    }
+
+    // Events are timed against a clock read that followed them
+    while ((s_flight < s_count) && (s_flight < (TRACE_ENTRIES - s_head))
+           && (s_queue[s_flight].generation != s_generation))
+    {
+        TraceEventStruct& event = s_queue[s_flight];
+        TraceEntryStruct& entry = s_burst[s_flight];
+
+        entry.tag = ((getValue(event.type) << 3) | ((s_sequence + s_flight) & TRACE_SEQUENCE_MASK));
+        entry.time = EntryTime(event.stamp);
+        entry.data[0] = event.data[0];
+        entry.data[1] = event.data[1];
+        s_flight++;
+    }
+
+    if (!s_flight)
+    {
+        return;
+    }
+
+    // Ring end splits a batch, the rest follows in the next burst
+    s_request.address = TWI_ADDRESS_DS3232;
+    s_request.reg = (TRACE_RING + (s_head * TRACE_ENTRY_BYTES));
+    s_request.data = reinterpret_cast<uint8_t*>(s_burst);
+    s_request.length = (s_flight * TRACE_ENTRY_BYTES);
+    s_request.read = false;
+    s_request.callback = nullptr;
+
+    if (!TwiSubmit(s_request))
+    {
+        s_flight = 0; // Queue full - retry next iteration
+    }
+}
+
+
+// Raw SRAM from the format byte - blocking
+bool TraceRead(const uint8_t offset, uint8_t* data, const uint8_t length)
+{
+    return g_rtc.ReadRegister((DS3232_REGISTER_SRAM + offset), data, length);
+}
+
+
+void GetTraceStatistics(TraceStatisticsStruct& statistics)
+{
+    statistics = s_statistics;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Trace.h
+ * @summary     Event trace in DS3232 SRAM for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _TRACE_H
+#define _TRACE_H
+
+#include "B7971-Nixie-Clock.h"
+
+// SRAM holds a format byte followed by a ring of fixed size entries
+const uint8_t TRACE_SRAM_BYTES = (0x100 - DS3232_REGISTER_SRAM);
+const uint8_t TRACE_MAGIC = 0xB7;
+const uint8_t TRACE_RING = (DS3232_REGISTER_SRAM + 1); // Register of entry 0
+const uint8_t TRACE_ENTRY_BYTES = 5;
+const uint8_t TRACE_ENTRIES = ((TRACE_SRAM_BYTES - 1) / TRACE_ENTRY_BYTES);
+const uint8_t TRACE_SEQUENCE_MASK = 0x07; // Tag bits 0-2, TRACE_ENTRIES is not a multiple
+const uint8_t TRACE_QUEUE = 6; // Events held in RAM until the next burst
+const uint8_t TRACE_TIMER = 0xFF; // ALARM source for a countdown
+const uint16_t TRACE_MINUTES = 1440; // Minutes per day
+
+enum class TraceType : uint8_t
+{
+    EMPTY,      // Never written
+    RESET,      // [MCUSR, SupervisorTask]
+    ALARM,      // [alarm index or TRACE_TIMER, song]
+    DISMISS,    // [seconds sounded, 1 if stopped by input]
+    BLANK,      // [1 blanked, 0 lit]
+    BRIGHTNESS, // [level, previous level]
+    CONFIG,     // [record bytes, version] - consecutive saves are merged
+    BATTERY,    // [millivolts (2)] on falling below BATTERY_MIN
+    COUNT,
+};
+
+// Stored layout, time is the DS3232 day of month and minute of day
+struct TraceEntryStruct
+{
+    uint8_t     tag;        // TraceType in bits 3-7, sequence in bits 0-2
+    uint16_t    time;       // (day - 1) in bits 11-15, minute of day in bits 0-10
+    uint8_t     data[2];
+} __attribute__((packed));
+
+static_assert(sizeof(TraceEntryStruct) == TRACE_ENTRY_BYTES, "Trace entry size");
+static_assert((TRACE_ENTRIES % (TRACE_SEQUENCE_MASK + 1)) != 0, "Trace head detection");
+
+inline bool TraceIsEntry(const TraceEntryStruct& entry)
+{
+    uint8_t type = (entry.tag >> 3);
+    return ((type != getValue(TraceType::EMPTY)) && (type < getValue(TraceType::COUNT)));
+}
+
+// Next was written after entry - the newest entry is the only one not followed
+inline bool TraceFollows(const TraceEntryStruct& entry, const TraceEntryStruct& next)
+{
+    return (TraceIsEntry(next) && ((next.tag & TRACE_SEQUENCE_MASK)
+                                   == ((entry.tag + 1) & TRACE_SEQUENCE_MASK)));
+}
+
+struct TraceStatisticsStruct
+{
+    TraceStatisticsStruct()
+    : recorded(0)
+    , bursts(0)
+    , dropped(0)
+    {
+        // empty
+    }
+
+    uint16_t recorded;  // Entries written to SRAM
+    uint16_t bursts;    // I2C writes carrying them
+    uint16_t dropped;   // Events lost to a full queue
+};
+
+void TraceInitialize(void);
+void TraceRecord(const TraceType type, const uint8_t data0, const uint8_t data1);
+void TraceTick(const CRTC::RTC& rtc);
+void TraceUpdate(void);
+bool TraceIsWaiting(void);
+bool TraceIsIdle(void);
+bool TraceRead(const uint8_t offset, uint8_t* data, const uint8_t length);
+void GetTraceStatistics(TraceStatisticsStruct& statistics);
+
+#endif
@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Twi.cpp
+ * @summary     Interrupt driven two-wire interface for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include <avr/sleep.h>
+#include <util/twi.h>
+#include "Twi.h"
+#include "Diagnostics.h"
+
+const uint32_t TWI_FREQUENCY = 400000UL; // DS3232 supports fast mode
+const uint8_t TWI_PIN_SDA = 4; // PC4
+const uint8_t TWI_PIN_SCL = 5; // PC5
+const uint8_t TWI_CONTROL = (_BV(TWINT) | _BV(TWEN) | _BV(TWIE));
+
+static TwiTransactionStruct* s_queue[TWI_QUEUE_SIZE];
+static volatile uint8_t s_head = 0; // Active transaction
+static volatile uint8_t s_count = 0;
+static uint8_t s_index = 0; // Data byte position
+static uint8_t s_attempt = 0;
+static uint8_t s_elapsed = 0; // milliseconds in current attempt
+static uint8_t s_backoff = 0; // milliseconds until retry
+static TwiStatisticsStruct s_statistics;
+
+
+static inline void TwiControl(const uint8_t flags)
+{
+    TWCR = (TWI_CONTROL | flags);
+}
+
+
+static void TwiStart(void)
+{
+    s_index = 0;
+    s_elapsed = 0;
+
+    while (TWCR & _BV(TWSTO)); // Previous STOP still on the bus
+
+    TwiControl(_BV(TWSTA));
+}
+
+
+// Sleep until TWI completion or millisecond tick - interrupts disabled
+static void TwiSleep(void)
+{
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_enable();
+    sei(); // Sleep executes before any pending interrupt
+    sleep_cpu();
+    sleep_disable();
+    cli();
+}
+
+
+// Release a slave holding SDA low by clocking SCL, then issue STOP
+static void TwiRecover(void)
+{
+    TWCR = 0; // Return pins to port control
+    PORTC &= ~(_BV(TWI_PIN_SDA) | _BV(TWI_PIN_SCL));
+    DDRC &= ~(_BV(TWI_PIN_SDA) | _BV(TWI_PIN_SCL));
+
+    for (uint8_t pulse = 0; (pulse < 9) && !(PINC & _BV(TWI_PIN_SDA)); pulse++)
+    {
+        DDRC |= _BV(TWI_PIN_SCL); // SCL low
+        delayMicroseconds(5);
+        DDRC &= ~_BV(TWI_PIN_SCL); // SCL released
+        delayMicroseconds(5);
+    }
+
+    // STOP: SDA rises while SCL is high
+    DDRC |= _BV(TWI_PIN_SDA);
+    delayMicroseconds(5);
+    DDRC &= ~_BV(TWI_PIN_SDA);
+    delayMicroseconds(5);
+
+    PORTC |= (_BV(TWI_PIN_SDA) | _BV(TWI_PIN_SCL)); // Pull-ups
+    TWCR = _BV(TWEN);
+    s_statistics.recoveries++;
+}
+
+
+// Retire active transaction and start the next - interrupts disabled
+static void TwiComplete(const TwiStatus status)
+{
+    TwiTransactionStruct& transaction = *s_queue[s_head];
+    uint32_t latency = (micros() - transaction.begin);
+
+    if (status == TwiStatus::COMPLETE)
+    {
+        s_statistics.completed++;
+    }
+    else
+    {
+        s_statistics.failed++;
+    }
+
+    s_statistics.latency_last = (latency > UINT16_MAX) ? UINT16_MAX : latency;
+
+    if (s_statistics.latency_last > s_statistics.latency_max)
+    {
+        s_statistics.latency_max = s_statistics.latency_last;
+    }
+
+    s_head = ((s_head + 1) % TWI_QUEUE_SIZE);
+    s_count--;
+    s_attempt = 0;
+    s_backoff = 0;
+    s_index = 0;
+    s_elapsed = 0;
+    transaction.status = status;
+
+    if (transaction.callback)
+    {
+        transaction.callback();
+    }
+
+    // STOP followed by START when more transactions are queued
+    TwiControl(_BV(TWSTO) | (s_count ? _BV(TWSTA) : 0));
+}
+
+
+// Abandon current attempt and schedule retry with exponential backoff
+static void TwiRetry(const bool recover)
+{
+    if (recover)
+    {
+        TwiRecover();
+    }
+    else
+    {
+        TwiControl(_BV(TWSTO));
+    }
+
+    if (s_attempt < TWI_RETRIES)
+    {
+        s_attempt++;
+        s_backoff = (1 << s_attempt); // 2, 4, 8 milliseconds
+        s_statistics.retries++;
+    }
+    else
+    {
+        TwiComplete(TwiStatus::FAILED);
+    }
+}
+
+
+void TwiInitialize(void)
+{
+    PORTC |= (_BV(TWI_PIN_SDA) | _BV(TWI_PIN_SCL)); // Pull-ups
+    TWSR = 0; // Prescaler of 1
+    TWBR = (((F_CPU / TWI_FREQUENCY) - 16) / 2);
+    TWCR = _BV(TWEN);
+}
+
+
+bool TwiSubmit(TwiTransactionStruct& transaction)
+{
+    uint8_t sreg = SREG;
+    bool result = false;
+
+    cli();
+
+    if ((s_count < TWI_QUEUE_SIZE) && (transaction.status != TwiStatus::PENDING))
+    {
+        transaction.status = TwiStatus::PENDING;
+        transaction.begin = micros();
+        s_queue[(s_head + s_count) % TWI_QUEUE_SIZE] = &transaction;
+
+        if (s_count++ == 0)
+        {
+            TwiStart();
+        }
+
+        result = true;
+    }
+
+    SREG = sreg;
+    return result;
+}
+
+
+bool TwiWait(TwiTransactionStruct& transaction)
+{
+    cli();
+
+    while (transaction.status == TwiStatus::PENDING)
+    {
+        TwiSleep();
+    }
+
+    sei();
+    return (transaction.status == TwiStatus::COMPLETE);
+}
+
+
+bool TwiIsIdle(void)
+{
+    return (s_count == 0);
+}
+
+
+// Called every millisecond - attempt timeout and retry backoff
+void TwiTick(void)
+{
+    if (s_count == 0)
+    {
+        return;
+    }
+
+    if (s_backoff)
+    {
+        if (--s_backoff == 0)
+        {
+            TwiStart();
+        }
+    }
+    else if (++s_elapsed > TWI_TIMEOUT)
+    {
+        TwiRetry(true); // Stuck bus or lost interrupt
+    }
+}
+
+
+void GetTwiStatistics(TwiStatisticsStruct& statistics)
+{
+    cli();
+    statistics = s_statistics;
+    sei();
+}
+
+
+bool TwiRead(const uint8_t address, const uint8_t reg, uint8_t* data, const uint8_t length)
+{
+    diagnosticsBlock();
+    TwiTransactionStruct transaction;
+    transaction.address = address;
+    transaction.reg = reg;
+    transaction.data = data;
+    transaction.length = length;
+    transaction.read = true;
+
+    cli();
+
+    while (!TwiSubmit(transaction))
+    {
+        TwiSleep(); // Queue full
+    }
+
+    sei();
+    return TwiWait(transaction);
+}
+
+
+bool TwiWrite(const uint8_t address, const uint8_t reg, const uint8_t* data, const uint8_t length)
+{
+    diagnosticsBlock();
+    TwiTransactionStruct transaction;
+    transaction.address = address;
+    transaction.reg = reg;
+    transaction.data = const_cast<uint8_t*>(data);
+    transaction.length = length;
+    transaction.read = false;
+
+    cli();
+
+    while (!TwiSubmit(transaction))
+    {
+        TwiSleep(); // Queue full
+    }
+
+    sei();
+    return TwiWait(transaction);
+}
+
+
+ISR(TWI_vect)
+{
+    TwiTransactionStruct& transaction = *s_queue[s_head];
+
+    switch (TW_STATUS)
+    {
+    case TW_START:
+        TWDR = ((transaction.address << 1) | TW_WRITE);
+        TwiControl(0);
+        break;
+    case TW_REP_START:
+        TWDR = ((transaction.address << 1) | TW_READ);
+        TwiControl(0);
+        break;
+    case TW_MT_SLA_ACK:
+        TWDR = transaction.reg; // Register pointer
+        TwiControl(0);
+        break;
+    case TW_MT_DATA_ACK:
+        if (transaction.read)
+        {
+            TwiControl(_BV(TWSTA)); // Repeated START for read phase
+        }
+        else if (s_index < transaction.length)
+        {
+            TWDR = transaction.data[s_index++];
+            TwiControl(0);
+        }
+        else
+        {
+            TwiComplete(TwiStatus::COMPLETE);
+        }
+        break;
+    case TW_MR_DATA_ACK:
+        transaction.data[s_index++] = TWDR;
+        [[gnu::fallthrough]]; // Fall-through
+    case TW_MR_SLA_ACK:
+        // ACK all bytes except the last
+        TwiControl((s_index < (transaction.length - 1)) ? _BV(TWEA) : 0);
+        break;
+    case TW_MR_DATA_NACK:
+        transaction.data[s_index++] = TWDR;
+        TwiComplete(TwiStatus::COMPLETE);
+        break;
+    case TW_MT_SLA_NACK:
+    case TW_MR_SLA_NACK:
+    case TW_MT_DATA_NACK:
+        TwiRetry(false);
+        break;
+    default: // Bus error or lost arbitration
+        TwiRetry(true);
+        break;
+    }
+}
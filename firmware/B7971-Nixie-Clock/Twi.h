@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Twi.h
+ * @summary     Interrupt driven two-wire interface for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _TWI_H
+#define _TWI_H
+
+#include <Arduino.h>
+
+const uint8_t TWI_ADDRESS_DS3232 = 0x68;
+const uint8_t TWI_QUEUE_SIZE = 4;       // Outstanding transactions
+const uint8_t TWI_RETRIES = 3;          // Attempts after the first failure
+const uint8_t TWI_TIMEOUT = 5;          // milliseconds per attempt
+
+enum class TwiStatus : uint8_t
+{
+    IDLE,
+    PENDING,
+    COMPLETE,
+    FAILED,
+};
+
+// Register read or write - storage must remain valid until completion
+struct TwiTransactionStruct
+{
+    TwiTransactionStruct()
+    : address(0)
+    , reg(0)
+    , data(nullptr)
+    , length(0)
+    , read(false)
+    , callback(nullptr)
+    , status(TwiStatus::IDLE)
+    , begin(0)
+    {
+        // empty
+    }
+
+    uint8_t             address;
+    uint8_t             reg;
+    uint8_t*            data;
+    uint8_t             length;
+    bool                read;
+    void                (*callback)(void); // Called from interrupt context
+    volatile TwiStatus  status;
+    uint32_t            begin; // micros() at submission
+};
+
+struct TwiStatisticsStruct
+{
+    TwiStatisticsStruct()
+    : completed(0)
+    , failed(0)
+    , retries(0)
+    , recoveries(0)
+    , latency_last(0)
+    , latency_max(0)
+    {
+        // empty
+    }
+
+    uint32_t completed;     // Transactions acknowledged by the slave
+    uint16_t failed;        // Transactions abandoned after all retries
+    uint16_t retries;       // Attempts repeated after NACK, bus error or timeout
+    uint16_t recoveries;    // SCL clock-out sequences
+    uint16_t latency_last;  // microseconds from submission to completion
+    uint16_t latency_max;
+};
+
+void TwiInitialize(void);
+bool TwiSubmit(TwiTransactionStruct& transaction);
+bool TwiWait(TwiTransactionStruct& transaction);
+bool TwiIsIdle(void);
+void TwiTick(void);
+void GetTwiStatistics(TwiStatisticsStruct& statistics);
+
+// Blocking register access
+bool TwiRead(const uint8_t address, const uint8_t reg, uint8_t* data, const uint8_t length);
+bool TwiWrite(const uint8_t address, const uint8_t reg, const uint8_t* data, const uint8_t length);
+
+#endif
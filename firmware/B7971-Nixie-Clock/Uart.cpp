@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Uart.cpp
+ * @summary     Interrupt driven USART0 ring buffers for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include "Uart.h"
+
+extern volatile bool g_wake_event;  // flag
+
+static_assert((UART_RX_SIZE & (UART_RX_SIZE - 1)) == 0, "Receive ring size");
+static_assert((UART_TX_SIZE & (UART_TX_SIZE - 1)) == 0, "Transmit ring size");
+
+// Each ring has one producer and one consumer - indices are single bytes
+static uint8_t s_rx[UART_RX_SIZE];
+static uint16_t s_rx_stamp[UART_RX_SIZE]; // millis() at the stop bit
+static uint8_t s_tx[UART_TX_SIZE];
+static volatile uint8_t s_rx_head = 0; // Written by USART_RX_vect
+static volatile uint8_t s_rx_tail = 0;
+static volatile uint8_t s_tx_head = 0;
+static volatile uint8_t s_tx_tail = 0; // Written by USART_UDRE_vect
+static bool s_tx_pending = false; // TXC0 not yet seen since the last write
+static volatile bool s_rx_active = false; // Bytes or a wake seen within UART_IDLE_TIMEOUT
+static volatile uint16_t s_rx_time = 0; // millis() at the last receive activity
+static UartStatisticsStruct s_statistics;
+
+
+void UartInitialize(void)
+{
+    // Double speed keeps the 16MHz divider error at 0.2%
+    UBRR0 = ((F_CPU / (8 * UART_BAUD)) - 1);
+    UCSR0A = _BV(U2X0);
+    UCSR0C = (_BV(UCSZ01) | _BV(UCSZ00)); // 8N1
+    UCSR0B = (_BV(RXCIE0) | _BV(RXEN0) | _BV(TXEN0));
+    PCMSK2 |= _BV(PCINT16); // RXD - enabled by UartSleep() during power-down only
+}
+
+
+// Stamp is the low 16 bits of millis() when the byte arrived
+bool UartRead(uint8_t& data, uint16_t& stamp)
+{
+    uint8_t tail = s_rx_tail;
+
+    if (tail == s_rx_head)
+    {
+        return false;
+    }
+
+    data = s_rx[tail & (UART_RX_SIZE - 1)];
+    stamp = s_rx_stamp[tail & (UART_RX_SIZE - 1)];
+    s_rx_tail = (tail + 1); // Release slot after copy
+    return true;
+}
+
+
+// Queues all of data or nothing - never waits for the transmitter
+bool UartWrite(const uint8_t* data, const uint8_t length)
+{
+    uint8_t head = s_tx_head;
+
+    if ((uint8_t)(UART_TX_SIZE - (uint8_t)(head - s_tx_tail)) < length)
+    {
+        return false;
+    }
+
+    for (uint8_t index = 0; index < length; index++)
+    {
+        s_tx[(head + index) & (UART_TX_SIZE - 1)] = data[index];
+    }
+
+    uint8_t sreg = SREG;
+    cli(); // UDRE handler clears UDRIE0
+    s_tx_head = (head + length);
+    UCSR0A |= _BV(TXC0); // Cleared by writing one
+    UCSR0B |= _BV(UDRIE0);
+    s_tx_pending = true;
+    s_statistics.transmitted += length;
+    SREG = sreg;
+    return true;
+}
+
+
+// USART clock halts in power-down - last stop bit must leave first
+// and a sender gets UART_IDLE_TIMEOUT to finish its frame or sentence
+bool UartIsIdle(void)
+{
+    if (s_tx_pending)
+    {
+        if ((UCSR0B & _BV(UDRIE0)) || !(UCSR0A & _BV(TXC0)))
+        {
+            return false;
+        }
+
+        s_tx_pending = false;
+    }
+
+    if (s_rx_active)
+    {
+        cli();
+        uint16_t time = s_rx_time;
+        sei();
+
+        if ((uint16_t)(millis() - time) < UART_IDLE_TIMEOUT)
+        {
+            return false;
+        }
+
+        s_rx_active = false;
+    }
+
+    return true;
+}
+
+
+// The RXD start bit wakes from power-down - the waking byte itself is lost
+void UartSleep(const bool power_down)
+{
+    if (power_down)
+    {
+        PCIFR = _BV(PCIF2); // Discard edges seen while awake
+        PCICR |= _BV(PCIE2);
+    }
+    else
+    {
+        PCICR &= ~_BV(PCIE2);
+    }
+}
+
+
+void GetUartStatistics(UartStatisticsStruct& statistics)
+{
+    cli();
+    statistics = s_statistics;
+    sei();
+}
+
+
+// Stay out of power-down while the sender is active
+static void UartActivity(void)
+{
+    s_rx_time = millis();
+    s_rx_active = true;
+}
+
+
+ISR(USART_RX_vect)
+{
+    uint8_t status = UCSR0A;
+    uint8_t data = UDR0;
+    uint8_t head = s_rx_head;
+
+    UartActivity();
+
+    if (status & _BV(FE0))
+    {
+        s_statistics.errors++;
+        return;
+    }
+
+    if (status & _BV(DOR0))
+    {
+        s_statistics.overruns++; // Earlier byte lost, this one is valid
+    }
+
+    if ((uint8_t)(head - s_rx_tail) >= UART_RX_SIZE)
+    {
+        s_statistics.overruns++; // Parser resynchronizes on the next frame
+        return;
+    }
+
+    s_rx[head & (UART_RX_SIZE - 1)] = data;
+    s_rx_stamp[head & (UART_RX_SIZE - 1)] = millis();
+    s_rx_head = (head + 1);
+    s_statistics.received++;
+    g_wake_event = true; // Wake main loop
+}
+
+
+ISR(USART_UDRE_vect)
+{
+    uint8_t tail = s_tx_tail;
+
+    if (tail == s_tx_head)
+    {
+        UCSR0B &= ~_BV(UDRIE0); // Ring drained
+        return;
+    }
+
+    UDR0 = s_tx[tail & (UART_TX_SIZE - 1)];
+    s_tx_tail = (tail + 1);
+}
+
+
+// RXD pin change - enabled during power-down only
+ISR(PCINT2_vect)
+{
+    UartActivity();
+    g_wake_event = true;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Uart.h
+ * @summary     Interrupt driven USART0 ring buffers for B7971-Nixie-Clock
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _UART_H
+#define _UART_H
+
+#include "B7971-Nixie-Clock.h"
+
+const uint32_t UART_BAUD = 38400;
+const uint8_t UART_RX_SIZE = 32; // Power of two
+const uint8_t UART_TX_SIZE = 64; // Power of two
+const uint16_t UART_IDLE_TIMEOUT = 2000; // Milliseconds without power-down after receive activity
+
+struct UartStatisticsStruct
+{
+    UartStatisticsStruct()
+    : received(0)
+    , transmitted(0)
+    , overruns(0)
+    , errors(0)
+    {
+        // empty
+    }
+
+    uint32_t received;      // Bytes queued for the main loop
+    uint32_t transmitted;   // Bytes handed to the transmitter
+    uint16_t overruns;      // Bytes lost to a full receive ring or data overrun
+    uint16_t errors;        // Bytes discarded with a framing error
+};
+
+void UartInitialize(void);
+bool UartRead(uint8_t& data, uint16_t& stamp);
+bool UartWrite(const uint8_t* data, const uint8_t length);
+bool UartIsIdle(void);
+void UartSleep(const bool power_down);
+void GetUartStatistics(UartStatisticsStruct& statistics);
+
+#endif
@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        IsrBench.c
+ * @summary     Cycle-accurate ISR and main loop benchmark on simavr
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <simavr/sim_avr.h>
+#include <simavr/sim_elf.h>
+#include <simavr/sim_io.h>
+#include <simavr/avr_ioport.h>
+
+#define F_CPU           16000000UL
+#define GPIOR2_ADDRESS  0x4B    // Data space address of GPIOR2
+#define MARKER_LOOP     1       // BENCH_MARKER_LOOP in B7971-Nixie-Clock.h
+#define NEST_DEPTH      8
+#define TRANSDUCERS     3
+
+// ATmega328P vector numbers
+enum
+{
+    VECTOR_INT0         = 1,
+    VECTOR_INT1         = 2,
+    VECTOR_PCINT1       = 4,
+    VECTOR_PCINT2       = 5,
+    VECTOR_WDT          = 6,
+    VECTOR_TIMER2_COMPA = 7,
+    VECTOR_TIMER1_COMPA = 11,
+    VECTOR_TIMER0_COMPA = 14,
+    VECTOR_TIMER0_OVF   = 16,
+    VECTOR_USART_RX     = 18,
+    VECTOR_USART_UDRE   = 19,
+    VECTOR_ADC          = 21,
+    VECTOR_EE_READY     = 22,
+    VECTOR_TWI          = 24,
+    VECTOR_COUNT        = 26,
+};
+
+typedef struct
+{
+    const char* name;
+    uint64_t count;
+    uint64_t total;     // Exclusive cycles
+    uint64_t min;
+    uint64_t max;
+    uint64_t max_inclusive;
+} stat_t;
+
+typedef struct
+{
+    int vector;
+    uint16_t sp;        // Stack pointer after return address push
+    uint64_t entry;
+    uint64_t nested;    // Cycles spent in nested interrupts
+} frame_t;
+
+static stat_t s_vector[VECTOR_COUNT];
+static stat_t s_loop = {"loop", 0, 0, UINT64_MAX, 0, 0};
+static uint64_t s_loop_mark = 0;
+static frame_t s_nest[NEST_DEPTH];
+static int s_depth = 0;
+
+// Audio edge timing per transducer pin
+static uint64_t s_edge_last[TRANSDUCERS];
+static uint64_t s_edge_period[TRANSDUCERS];
+static uint64_t s_edge_count = 0;
+static double s_jitter_sum = 0;
+static uint64_t s_jitter_max = 0;
+static uint64_t s_jitter_count = 0;
+
+
+static void Record(stat_t* stat, const uint64_t exclusive, const uint64_t inclusive)
+{
+    stat->count++;
+    stat->total += exclusive;
+    stat->min = (exclusive < stat->min) ? exclusive : stat->min;
+    stat->max = (exclusive > stat->max) ? exclusive : stat->max;
+    stat->max_inclusive = (inclusive > stat->max_inclusive) ? inclusive : stat->max_inclusive;
+}
+
+
+static void MarkerWrite(struct avr_t* avr, avr_io_addr_t address, uint8_t value, void* param)
+{
+    (void)address;
+    (void)param;
+
+    if (value == MARKER_LOOP)
+    {
+        if (s_loop_mark)
+        {
+            uint64_t elapsed = avr->cycle - s_loop_mark;
+            Record(&s_loop, elapsed, elapsed);
+        }
+
+        s_loop_mark = avr->cycle;
+    }
+}
+
+
+static void TransducerEdge(struct avr_irq_t* irq, uint32_t value, void* param)
+{
+    avr_t* avr = (avr_t*)param;
+    int pin = irq->irq - 5; // PD5..PD7
+    (void)value;
+
+    if ((pin < 0) || (pin >= TRANSDUCERS))
+    {
+        return;
+    }
+
+    if (s_edge_last[pin])
+    {
+        uint64_t period = avr->cycle - s_edge_last[pin];
+
+        // Compare consecutive half periods within a tone (ignore note changes)
+        if (s_edge_period[pin] && (period < (2 * s_edge_period[pin])) && ((2 * period) > s_edge_period[pin]))
+        {
+            uint64_t jitter = (period > s_edge_period[pin]) ? (period - s_edge_period[pin])
+                                                            : (s_edge_period[pin] - period);
+            s_jitter_sum += jitter;
+            s_jitter_max = (jitter > s_jitter_max) ? jitter : s_jitter_max;
+            s_jitter_count++;
+        }
+
+        s_edge_period[pin] = period;
+    }
+
+    s_edge_last[pin] = avr->cycle;
+    s_edge_count++;
+}
+
+
+static uint16_t StackPointer(const avr_t* avr)
+{
+    return (avr->data[R_SPL] | (avr->data[R_SPH] << 8));
+}
+
+
+static void Track(avr_t* avr)
+{
+    uint16_t sp = StackPointer(avr);
+
+    // Return from interrupt pops the return address above entry stack pointer
+    while ((s_depth > 0) && (sp > s_nest[s_depth - 1].sp))
+    {
+        frame_t* frame = &s_nest[--s_depth];
+        uint64_t inclusive = avr->cycle - frame->entry;
+        Record(&s_vector[frame->vector], inclusive - frame->nested, inclusive);
+
+        if (s_depth > 0)
+        {
+            s_nest[s_depth - 1].nested += inclusive;
+        }
+    }
+
+    if ((avr->pc % avr->vector_size) == 0)
+    {
+        int vector = avr->pc / avr->vector_size;
+
+        if ((vector > 0) && (vector < VECTOR_COUNT) && s_vector[vector].name && (s_depth < NEST_DEPTH))
+        {
+            // Interrupt entry: 4 cycles of vectoring already counted
+            if ((s_depth == 0) || (s_nest[s_depth - 1].entry != avr->cycle))
+            {
+                frame_t frame = {vector, sp, avr->cycle, 0};
+                s_nest[s_depth++] = frame;
+            }
+        }
+    }
+}
+
+
+static void Encoder(avr_t* avr, avr_irq_t* a, avr_irq_t* b, const uint64_t step)
+{
+    // One CW detent: 11 -> 01 -> 00 -> 10 -> 11
+    static const uint8_t sequence[] = {0x3, 0x1, 0x0, 0x2};
+    uint8_t state = sequence[step % 4];
+    avr_raise_irq(a, (state >> 1) & 0x1);
+    avr_raise_irq(b, state & 0x1);
+    (void)avr;
+}
+
+
+static void PrintStat(const stat_t* stat, const uint64_t cycles, const int last)
+{
+    double mean = stat->count ? ((double)stat->total / stat->count) : 0;
+
+    printf("    \"%s\": {\"count\": %llu, \"min\": %llu, \"mean\": %.1f, \"max\": %llu, "
+           "\"max_inclusive\": %llu, \"cpu_share\": %.5f}%s\n",
+           stat->name,
+           (unsigned long long)stat->count,
+           (unsigned long long)(stat->count ? stat->min : 0),
+           mean,
+           (unsigned long long)stat->max,
+           (unsigned long long)stat->max_inclusive,
+           cycles ? ((double)stat->total / cycles) : 0,
+           last ? "" : ",");
+}
+
+
+int main(int argc, char** argv)
+{
+    const char* image;
+    const char* label;
+    double seconds = 5;
+    double encoder_hz = 4;
+    elf_firmware_t firmware;
+
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: %s IMAGE.elf LABEL [SECONDS] [ENCODER_HZ]\n", argv[0]);
+        return 1;
+    }
+
+    image = argv[1];
+    label = argv[2];
+    seconds = (argc > 3) ? atof(argv[3]) : seconds;
+    encoder_hz = (argc > 4) ? atof(argv[4]) : encoder_hz;
+
+    memset(&firmware, 0, sizeof(firmware));
+
+    if (elf_read_firmware(image, &firmware) != 0)
+    {
+        fprintf(stderr, "unable to read %s\n", image);
+        return 1;
+    }
+
+    avr_t* avr = avr_make_mcu_by_name("atmega328p");
+
+    if (!avr)
+    {
+        fprintf(stderr, "atmega328p core not available\n");
+        return 1;
+    }
+
+    avr_init(avr);
+    avr_load_firmware(avr, &firmware);
+    avr->frequency = F_CPU;
+    avr->log = LOG_NONE;
+
+    s_vector[VECTOR_INT0] = (stat_t){"INT0_encoder", 0, 0, UINT64_MAX, 0, 0};
+    s_vector[VECTOR_INT1] = (stat_t){"INT1_encoder", 0, 0, UINT64_MAX, 0, 0};
+    s_vector[VECTOR_PCINT1] = (stat_t){"PCINT1_rtc_tick", 0, 0, UINT64_MAX, 0, 0};
+    s_vector[VECTOR_PCINT2] = (stat_t){"PCINT2_button_rxd", 0, 0, UINT64_MAX, 0, 0};
+    s_vector[VECTOR_WDT] = (stat_t){"WDT_supervisor", 0, 0, UINT64_MAX, 0, 0};
+    s_vector[VECTOR_TIMER2_COMPA] = (stat_t){"TIMER2_COMPA_display", 0, 0, UINT64_MAX, 0, 0};
+    s_vector[VECTOR_TIMER1_COMPA] = (stat_t){"TIMER1_COMPA_audio", 0, 0, UINT64_MAX, 0, 0};
+    s_vector[VECTOR_TIMER0_COMPA] = (stat_t){"TIMER0_COMPA_tick", 0, 0, UINT64_MAX, 0, 0};
+    s_vector[VECTOR_TIMER0_OVF] = (stat_t){"TIMER0_OVF_millis", 0, 0, UINT64_MAX, 0, 0};
+    s_vector[VECTOR_USART_RX] = (stat_t){"USART_RX_protocol", 0, 0, UINT64_MAX, 0, 0};
+    s_vector[VECTOR_USART_UDRE] = (stat_t){"USART_UDRE_protocol", 0, 0, UINT64_MAX, 0, 0};
+    s_vector[VECTOR_ADC] = (stat_t){"ADC_sensor", 0, 0, UINT64_MAX, 0, 0};
+    s_vector[VECTOR_EE_READY] = (stat_t){"EE_READY_journal", 0, 0, UINT64_MAX, 0, 0};
+    s_vector[VECTOR_TWI] = (stat_t){"TWI_rtc", 0, 0, UINT64_MAX, 0, 0};
+
+    avr_register_io_write(avr, GPIOR2_ADDRESS, MarkerWrite, NULL);
+
+    for (int pin = 0; pin < TRANSDUCERS; pin++)
+    {
+        avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), 5 + pin),
+                                TransducerEdge, avr);
+    }
+
+    avr_irq_t* encoder_a = avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), 2);
+    avr_irq_t* encoder_b = avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), 3);
+    avr_irq_t* button = avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), 4);
+    avr_raise_irq(encoder_a, 1);
+    avr_raise_irq(encoder_b, 1);
+    avr_raise_irq(button, 1); // Released
+
+    uint64_t limit = (uint64_t)(seconds * F_CPU);
+    uint64_t encoder_start = F_CPU; // Let setup() and loop() settle
+    uint64_t encoder_interval = (encoder_hz > 0) ? (uint64_t)(F_CPU / (encoder_hz * 4)) : 0;
+    uint64_t encoder_next = encoder_start;
+    uint64_t encoder_step = 0;
+    int state = cpu_Running;
+
+    while ((avr->cycle < limit) && (state != cpu_Done) && (state != cpu_Crashed))
+    {
+        state = avr_run(avr);
+        Track(avr);
+
+        if (encoder_interval && (avr->cycle >= encoder_next))
+        {
+            Encoder(avr, encoder_a, encoder_b, ++encoder_step);
+            encoder_next += encoder_interval;
+        }
+    }
+
+    uint64_t cycles = avr->cycle;
+
+    printf("{\n");
+    printf("  \"image\": \"%s\",\n", image);
+    printf("  \"label\": \"%s\",\n", label);
+    printf("  \"f_cpu\": %lu,\n", F_CPU);
+    printf("  \"cycles\": %llu,\n", (unsigned long long)cycles);
+    printf("  \"state\": \"%s\",\n", (state == cpu_Crashed) ? "crashed" : "ok");
+    printf("  \"isr\": {\n");
+
+    int last = 0;
+
+    for (int vector = 0; vector < VECTOR_COUNT; vector++)
+    {
+        if (s_vector[vector].name)
+        {
+            last = vector;
+        }
+    }
+
+    for (int vector = 0; vector < VECTOR_COUNT; vector++)
+    {
+        if (s_vector[vector].name)
+        {
+            PrintStat(&s_vector[vector], cycles, vector == last);
+        }
+    }
+
+    printf("  },\n");
+    printf("  \"main\": {\n");
+    PrintStat(&s_loop, cycles, 1);
+    printf("  },\n");
+    printf("  \"audio\": {\"edges\": %llu, \"jitter_mean\": %.2f, \"jitter_max\": %llu}\n",
+           (unsigned long long)s_edge_count,
+           s_jitter_count ? (s_jitter_sum / s_jitter_count) : 0.0,
+           (unsigned long long)s_jitter_max);
+    printf("}\n");
+
+    return (state == cpu_Crashed) ? 2 : 0;
+}
@@ -0,0 +1,1201 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Host.cpp
+ * @summary     Virtual clock and AVR peripheral shims for the host build
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include <Arduino.h>
+#include <avr/eeprom.h>
+#include <avr/wdt.h>
+#include <avr/sleep.h>
+#include <util/twi.h>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include "Host.h"
+
+//---------------------------------------------------------------------
+// Interrupt vectors provided by the firmware
+//---------------------------------------------------------------------
+
+extern "C" void TIMER0_COMPA_vect(void) __attribute__((weak));
+extern "C" void TIMER2_COMPA_vect(void) __attribute__((weak));
+extern "C" void PCINT1_vect(void) __attribute__((weak));
+extern "C" void PCINT2_vect(void) __attribute__((weak));
+extern "C" void TWI_vect(void) __attribute__((weak));
+extern "C" void ADC_vect(void) __attribute__((weak));
+extern "C" void EE_READY_vect(void) __attribute__((weak));
+extern "C" void USART_RX_vect(void) __attribute__((weak));
+extern "C" void USART_UDRE_vect(void) __attribute__((weak));
+extern "C" void WDT_vect(void) __attribute__((weak));
+
+//---------------------------------------------------------------------
+// Registers
+//---------------------------------------------------------------------
+
+static void ChainWrite(const uint8_t previous, const uint8_t value);
+static uint8_t TwiControlRead(const uint8_t value);
+static void TwiControlWrite(const uint8_t previous, const uint8_t value);
+static uint8_t EepromControlRead(const uint8_t value);
+static void EepromControlWrite(const uint8_t previous, const uint8_t value);
+static uint8_t UartStatusRead(const uint8_t value);
+static void UartStatusWrite(const uint8_t previous, const uint8_t value);
+static uint8_t UartDataRead(const uint8_t value);
+static void UartDataWrite(const uint8_t previous, const uint8_t value);
+
+HostRegister PORTB{nullptr, ChainWrite};
+HostRegister PORTC;
+HostRegister PORTD;
+HostRegister TWCR{TwiControlRead, TwiControlWrite};
+HostRegister EECR{EepromControlRead, EepromControlWrite};
+HostRegister UCSR0A{UartStatusRead, UartStatusWrite};
+HostRegister UCSR0B;
+HostRegister UDR0{UartDataRead, UartDataWrite};
+
+volatile uint8_t DDRB, DDRC, DDRD;
+volatile uint8_t PINB, PIND;
+volatile uint8_t PINC = _BV(1) | _BV(4) | _BV(5); // INT/SQW, SDA and SCL pulled up
+volatile uint8_t EICRA, EIMSK, EIFR, PCICR, PCIFR, PCMSK0, PCMSK1, PCMSK2;
+volatile uint8_t TWBR, TWSR = 0xF8, TWAR, TWDR, TWAMR;
+volatile uint8_t GPIOR0, GPIOR1, GPIOR2;
+volatile uint8_t MCUSR = _BV(PORF); // Power-on reset
+volatile uint8_t WDTCSR;
+volatile uint8_t TCCR0A, TCCR0B, TCNT0, OCR0A, OCR0B, TIMSK0, TIFR0;
+volatile uint8_t TCCR2A, TCCR2B, TCNT2, OCR2A, OCR2B, TIMSK2, TIFR2;
+volatile uint8_t EEDR;
+volatile uint16_t EEAR;
+volatile uint8_t ADMUX, ADCSRA, ADCSRB, DIDR0;
+volatile uint16_t ADC;
+volatile uint8_t UCSR0C;
+volatile uint16_t UBRR0;
+volatile uint8_t SREG = _BV(SREG_I);
+
+//---------------------------------------------------------------------
+// Simulation state
+//---------------------------------------------------------------------
+
+struct HostEventStruct
+{
+    uint64_t us;
+    HostInput input;
+};
+
+static uint64_t s_now = 0;
+static uint64_t s_limit = UINT64_MAX;
+static const uint64_t TIMER0_PERIOD = 1024; // 16MHz / (64 prescaler * 256) - OCR0A does not clear the count
+static uint64_t s_timer0_next = TIMER0_PERIOD;
+static uint64_t s_timer2_next = 0;
+static bool s_in_interrupt = false;
+static std::vector<HostEventStruct> s_events;
+static uint16_t s_analog[8] = {0, 0, 510, 200, 0, 0, 0, 0};
+static uint8_t s_eeprom[E2END + 1];
+static bool s_eeprom_init = false;
+static bool s_eeprom_busy = false;     // EEPE - cell being programmed
+static uint64_t s_eeprom_done = 0;
+static uint16_t s_eeprom_wear[E2END + 1];
+static HostEepromStruct s_eeprom_statistics;
+static bool s_wdt_enabled = false;
+static uint64_t s_wdt_timeout = 0;
+static uint64_t s_wdt_feed = 0;
+static uint32_t s_interrupt_count = 0;
+static bool s_pcint1_pending = false;
+static bool s_pcint2_pending = false;  // RXD start bit while the USART is halted
+
+// ADC auto-triggered by Timer0 compare match A
+static bool s_adc_busy = false;
+static uint64_t s_adc_done = 0;
+static uint8_t s_adc_channel = 0;
+static uint16_t s_adc_noise = 0;    // Peak deviation in LSB
+static uint32_t s_adc_seed = 1;
+
+// Sleep
+static uint8_t s_sleep_mode = SLEEP_MODE_IDLE;
+static bool s_sleep_enabled = false;
+static bool s_power_down = false;
+static HostPowerStruct s_power;
+
+// Two-wire interface with a single DS3232 slave
+enum class TwiState : uint8_t
+{
+    IDLE,
+    ADDRESS,
+    WRITE,
+    READ,
+};
+
+static TwiState s_twi_state = TwiState::IDLE;
+static bool s_twi_pointer_pending = false;  // Next written byte sets the register pointer
+static uint8_t s_twi_pointer = 0;
+static uint8_t s_twi_bytes = 0;
+static bool s_twi_flag = false;             // TWINT
+static bool s_twi_busy = false;             // Bus event in flight until s_twi_done
+static uint64_t s_twi_done = 0;
+static HostBusStruct s_bus;
+static uint64_t s_bus_fault_begin = 0;
+static uint64_t s_bus_fault_end = 0;
+
+// DS3232 INT/SQW output sampled at each half second of its oscillator
+static bool s_rtc_pin = true;
+static bool s_rtc_wired = true; // INT/SQW reworked to A1
+static uint64_t s_rtc_pin_next = 0;
+
+// USART0 connected to a pseudo terminal
+static int s_uart_fd = -1;                  // Master side, -1 when not opened
+static int s_uart_slave = -1;               // Held open so the master survives client restarts
+static std::deque<uint8_t> s_uart_line;     // Bytes written by the client, not yet received
+static uint64_t s_uart_poll_next = 0;
+static uint64_t s_uart_rx_done = 0;         // Stop bit of the byte being received
+static bool s_uart_rx_busy = false;
+static bool s_uart_rxc = false;             // RXC0 - UDR0 holds a received byte
+static bool s_uart_dor = false;             // DOR0
+static uint8_t s_uart_rdr = 0;
+static bool s_uart_udr_full = false;        // UDRE0 clear
+static uint8_t s_uart_udr = 0;
+static bool s_uart_tx_busy = false;         // Shift register in use until s_uart_tx_done
+static uint8_t s_uart_tx_shift = 0;
+static uint64_t s_uart_tx_done = 0;
+static bool s_uart_txc = false;             // TXC0
+static std::chrono::steady_clock::time_point s_uart_epoch;
+static double s_uart_rate = 1.0;            // Simulated seconds per wall-clock second
+
+// HV5622 chain - 6 devices of 16 outputs each
+static unsigned __int128 s_chain_shift = 0;
+static uint64_t s_chain_latch_us = 0;
+static HostChainStruct s_chain;
+
+extern void HostDispatchInput(const HostInput input); // Library.cpp
+static void PollUart(void);
+static void CompleteUartReceive(void);
+static void CompleteUartTransmit(void);
+
+//---------------------------------------------------------------------
+// Virtual clock
+//---------------------------------------------------------------------
+
+static void RunInterrupt(void (*vector)(void));
+
+
+static void UpdateRTCPin(void)
+{
+    bool level = (HostDS3232Pin() || !s_rtc_wired); // Pulled up when not connected
+
+    if (level != s_rtc_pin)
+    {
+        s_rtc_pin = level;
+        PINC = level ? (PINC | _BV(1)) : (PINC & ~_BV(1));
+
+        if ((PCICR & _BV(PCIE1)) && (PCMSK1 & _BV(PCINT9)))
+        {
+            s_pcint1_pending = true;
+        }
+    }
+}
+
+
+static void CompleteTwi(void)
+{
+    s_twi_busy = false;
+    s_twi_flag = true;
+}
+
+
+static uint32_t Timer2PeriodMicros(void)
+{
+    static const uint16_t prescale[] = {0, 1, 8, 32, 64, 128, 256, 1024};
+    uint16_t divider = prescale[TCCR2B & 0x07];
+
+    if (divider == 0)
+    {
+        return 0;
+    }
+
+    // CTC mode: 16 MHz / prescale / (OCR2A + 1)
+    return ((uint32_t)(OCR2A + 1) * divider) / 16;
+}
+
+
+static void RunInterrupt(void (*vector)(void))
+{
+    if (vector)
+    {
+        uint8_t sreg = SREG;
+        bool nested = s_in_interrupt;
+        s_in_interrupt = true;
+        SREG &= ~_BV(SREG_I);
+        vector();
+        SREG = sreg;
+        s_in_interrupt = nested;
+        s_interrupt_count++;
+    }
+}
+
+
+uint64_t HostMicros(void)
+{
+    return s_now;
+}
+
+
+void HostSetLimit(const uint64_t us)
+{
+    s_limit = us;
+}
+
+
+static void StartAdc(void)
+{
+    const uint8_t trigger = (_BV(ADEN) | _BV(ADATE));
+
+    if (s_adc_busy || ((ADCSRA & trigger) != trigger) || ((ADCSRB & 0x07) != (_BV(ADTS1) | _BV(ADTS0))))
+    {
+        return;
+    }
+
+    // 13 ADC clocks, channel latched at start of conversion
+    uint8_t prescaler = (1 << std::max(1, (ADCSRA & 0x07)));
+    s_adc_busy = true;
+    s_adc_done = s_now + ((13 * prescaler) / (F_CPU / 1000000));
+    s_adc_channel = (ADMUX & 0x07);
+}
+
+
+static void CompleteAdc(void)
+{
+    int32_t value = s_analog[s_adc_channel];
+
+    if (s_adc_noise)
+    {
+        s_adc_seed = (s_adc_seed * 1103515245) + 12345;
+        value += (int32_t)((s_adc_seed >> 16) % ((2 * s_adc_noise) + 1)) - s_adc_noise;
+    }
+
+    ADC = std::min(std::max(value, (int32_t)0), (int32_t)1023);
+    ADCSRA |= _BV(ADIF);
+    s_adc_busy = false;
+}
+
+
+void HostAdvance(const uint64_t us)
+{
+    // ISRs observe time but never advance it
+    if (s_in_interrupt)
+    {
+        return;
+    }
+
+    uint64_t target = s_now + us;
+
+    while (s_now < target)
+    {
+        uint64_t next = target;
+        bool timer0 = !s_power_down && (TIMSK0 & _BV(OCIE0A));
+        bool timer2 = !s_power_down && (TIMSK2 & _BV(OCIE2A)) && Timer2PeriodMicros();
+
+        if (timer2 && (s_timer2_next <= s_now))
+        {
+            s_timer2_next = s_now + Timer2PeriodMicros();
+        }
+
+        if (timer0)
+        {
+            next = std::min(next, s_timer0_next);
+        }
+
+        if (timer2)
+        {
+            next = std::min(next, s_timer2_next);
+        }
+
+        if (s_twi_busy)
+        {
+            next = std::min(next, s_twi_done);
+        }
+
+        if (s_adc_busy)
+        {
+            next = std::min(next, s_adc_done);
+        }
+
+        if (s_eeprom_busy)
+        {
+            next = std::min(next, s_eeprom_done);
+        }
+
+        if (!s_events.empty())
+        {
+            next = std::min(next, s_events.front().us);
+        }
+
+        if (s_uart_fd >= 0)
+        {
+            next = std::min(next, s_uart_poll_next);
+        }
+
+        if (s_uart_rx_busy)
+        {
+            next = std::min(next, s_uart_rx_done);
+        }
+
+        if (s_uart_tx_busy)
+        {
+            next = std::min(next, s_uart_tx_done);
+        }
+
+        next = std::min(next, s_rtc_pin_next);
+        s_now = std::max(s_now, next);
+
+        while (!s_events.empty() && (s_events.front().us <= s_now))
+        {
+            HostInput input = s_events.front().input;
+            s_events.erase(s_events.begin());
+            HostDispatchInput(input);
+            s_interrupt_count++;
+        }
+
+        if (s_rtc_pin_next <= s_now)
+        {
+            UpdateRTCPin();
+            s_rtc_pin_next = std::max(HostDS3232NextEdge(), (s_now + 1)); // Rounding never stalls
+        }
+
+        if ((s_uart_fd >= 0) && (s_uart_poll_next <= s_now))
+        {
+            s_uart_poll_next = s_now + std::max<uint64_t>(1000, (s_uart_rate * 20));
+            PollUart();
+        }
+
+        if (s_uart_rx_busy && (s_uart_rx_done <= s_now))
+        {
+            CompleteUartReceive();
+        }
+
+        if (s_uart_tx_busy && (s_uart_tx_done <= s_now))
+        {
+            CompleteUartTransmit();
+        }
+
+        // RXC and UDRE are level triggered while enabled
+        if (s_uart_rxc && (UCSR0B & _BV(RXCIE0)) && (SREG & _BV(SREG_I)))
+        {
+            RunInterrupt(USART_RX_vect);
+        }
+
+        if (!s_uart_udr_full && (UCSR0B & _BV(UDRIE0)) && (SREG & _BV(SREG_I)))
+        {
+            RunInterrupt(USART_UDRE_vect);
+        }
+
+        if (s_pcint1_pending && (SREG & _BV(SREG_I)))
+        {
+            s_pcint1_pending = false;
+            RunInterrupt(PCINT1_vect);
+        }
+
+        if (s_pcint2_pending && (SREG & _BV(SREG_I)))
+        {
+            s_pcint2_pending = false;
+            RunInterrupt(PCINT2_vect);
+        }
+
+        if (s_twi_busy && (s_twi_done <= s_now))
+        {
+            CompleteTwi();
+
+            if (TWCR & _BV(TWIE))
+            {
+                RunInterrupt(TWI_vect);
+            }
+        }
+
+        if (s_adc_busy && (s_adc_done <= s_now))
+        {
+            CompleteAdc();
+
+            if (ADCSRA & _BV(ADIE))
+            {
+                ADCSRA &= ~_BV(ADIF);
+                RunInterrupt(ADC_vect);
+            }
+        }
+
+        if (s_eeprom_busy && (s_eeprom_done <= s_now))
+        {
+            s_eeprom_busy = false;
+        }
+
+        // EE_READY is level triggered while EERIE is set
+        if (!s_eeprom_busy && (EECR & _BV(EERIE)) && (SREG & _BV(SREG_I)))
+        {
+            RunInterrupt(EE_READY_vect);
+        }
+
+        if (timer0 && (s_timer0_next <= s_now))
+        {
+            s_timer0_next += TIMER0_PERIOD;
+            StartAdc();
+            RunInterrupt(TIMER0_COMPA_vect);
+        }
+
+        if (timer2 && (s_timer2_next <= s_now))
+        {
+            RunInterrupt(TIMER2_COMPA_vect);
+            s_timer2_next = s_now + Timer2PeriodMicros(); // OCR2A may be reprogrammed
+        }
+
+        if (s_wdt_enabled && ((s_now - s_wdt_feed) > s_wdt_timeout))
+        {
+            // Interrupt and system reset mode - the interrupt clears WDIE, next timeout resets
+            if (WDTCSR & _BV(WDIE))
+            {
+                WDTCSR &= ~_BV(WDIE);
+                s_wdt_feed = s_now;
+
+                if (SREG & _BV(SREG_I))
+                {
+                    RunInterrupt(WDT_vect);
+                }
+            }
+            else
+            {
+                fprintf(stderr, "[%10.3f] watchdog reset\n", s_now / 1e6);
+                throw HostStop();
+            }
+        }
+
+        if (s_now >= s_limit)
+        {
+            throw HostStop();
+        }
+    }
+}
+
+
+void HostScheduleInput(const uint64_t ms, const HostInput input)
+{
+    HostEventStruct event = {ms * 1000, input};
+    auto position = std::upper_bound(s_events.begin(), s_events.end(), event,
+        [](const HostEventStruct& a, const HostEventStruct& b) { return a.us < b.us; });
+    s_events.insert(position, event);
+}
+
+
+void HostSetAnalog(const uint8_t channel, const uint16_t value)
+{
+    s_analog[channel & 0x07] = value;
+}
+
+
+void HostSetAnalogNoise(const uint16_t noise)
+{
+    s_adc_noise = noise;
+}
+
+//---------------------------------------------------------------------
+// HV5622 chain model
+//---------------------------------------------------------------------
+
+static void AccumulateChain(void)
+{
+    uint64_t elapsed = s_now - s_chain_latch_us;
+
+    for (uint8_t tube = 0; tube < HOST_TUBE_COUNT; tube++)
+    {
+        if (s_chain.latched[tube])
+        {
+            s_chain.on_time[tube] += elapsed;
+        }
+    }
+
+    s_chain_latch_us = s_now;
+}
+
+
+const HostChainStruct& HostGetChain(void)
+{
+    AccumulateChain();
+    return s_chain;
+}
+
+
+void HostResetChainStatistics(void)
+{
+    AccumulateChain();
+    memset(s_chain.on_time, 0, sizeof(s_chain.on_time));
+    s_chain.shift_count = 0;
+    s_chain.latch_count = 0;
+    s_chain.window_begin = s_now;
+}
+
+
+static void ChainWrite(const uint8_t previous, const uint8_t value)
+{
+    // CLOCK = PB1, SDATA = PB3, LATCH = PB4
+    if ((previous & _BV(1)) && !(value & _BV(1)))
+    {
+        // Data is sampled on the falling clock edge
+        s_chain_shift = (s_chain_shift << 1) | ((value >> 3) & 0x1);
+        s_chain.shift_count++;
+    }
+
+    if (!(previous & _BV(4)) && (value & _BV(4)))
+    {
+        AccumulateChain();
+
+        for (uint8_t tube = 0; tube < HOST_TUBE_COUNT; tube++)
+        {
+            s_chain.latched[tube] = (uint16_t)(s_chain_shift >> (16 * tube));
+        }
+
+        s_chain.latch_count++;
+    }
+}
+
+//---------------------------------------------------------------------
+// Two-wire interface model
+//---------------------------------------------------------------------
+
+static uint8_t TwiControlRead(const uint8_t value)
+{
+    // Polling CPU spins until the bus event completes
+    if (s_twi_busy && !s_in_interrupt)
+    {
+        HostAdvance(1);
+    }
+
+    return (value & ~(_BV(TWINT) | _BV(TWSTO))) | (s_twi_flag ? _BV(TWINT) : 0);
+}
+
+
+static void TwiControlWrite(const uint8_t, const uint8_t value)
+{
+    // SCL = F_CPU / (16 + 2 * TWBR * prescale)
+    static const uint8_t prescale[] = {1, 4, 16, 64};
+    uint32_t bit_us = (16 + (2UL * TWBR * prescale[TWSR & 0x03])) / 16;
+
+    if (!(value & _BV(TWEN)))
+    {
+        s_twi_state = TwiState::IDLE;
+        s_twi_flag = false;
+        s_twi_busy = false;
+        return;
+    }
+
+    // Writing one to TWINT clears the flag and starts the next bus event
+    if (!(value & _BV(TWINT)))
+    {
+        return;
+    }
+
+    s_twi_flag = false;
+
+    if ((s_now >= s_bus_fault_begin) && (s_now < s_bus_fault_end))
+    {
+        // Bus held by the slave - event never completes
+        s_twi_busy = false;
+        return;
+    }
+
+    if (value & _BV(TWSTO))
+    {
+        if (s_twi_state != TwiState::IDLE)
+        {
+            HostBusTransaction(s_twi_bytes);
+        }
+
+        s_twi_state = TwiState::IDLE;
+        s_twi_busy = false;
+        UpdateRTCPin(); // Register writes may release INT
+
+        // STOP followed by START when both are written
+        if (!(value & _BV(TWSTA)))
+        {
+            return;
+        }
+    }
+
+    uint8_t status = TWSR & 0x03;
+
+    if (value & _BV(TWSTA))
+    {
+        status |= (s_twi_state == TwiState::IDLE) ? TW_START : TW_REP_START;
+
+        if (s_twi_state == TwiState::IDLE)
+        {
+            s_twi_bytes = 0;
+        }
+
+        s_twi_state = TwiState::ADDRESS;
+        s_twi_done = s_now + bit_us;
+    }
+    else
+    {
+        s_twi_bytes++;
+        s_twi_done = s_now + (9 * bit_us);
+
+        switch (s_twi_state)
+        {
+        case TwiState::ADDRESS:
+            if ((TWDR >> 1) != HOST_DS3232_ADDRESS)
+            {
+                status |= (TWDR & TW_READ) ? TW_MR_SLA_NACK : TW_MT_SLA_NACK;
+            }
+            else if (TWDR & TW_READ)
+            {
+                status |= TW_MR_SLA_ACK;
+                s_twi_state = TwiState::READ;
+            }
+            else
+            {
+                status |= TW_MT_SLA_ACK;
+                s_twi_state = TwiState::WRITE;
+                s_twi_pointer_pending = true;
+            }
+            break;
+        case TwiState::WRITE:
+            if (s_twi_pointer_pending)
+            {
+                s_twi_pointer = TWDR;
+                s_twi_pointer_pending = false;
+            }
+            else
+            {
+                HostDS3232Write(s_twi_pointer++, TWDR);
+            }
+
+            status |= TW_MT_DATA_ACK;
+            break;
+        case TwiState::READ:
+            TWDR = HostDS3232Read(s_twi_pointer++);
+            status |= (value & _BV(TWEA)) ? TW_MR_DATA_ACK : TW_MR_DATA_NACK;
+            break;
+        case TwiState::IDLE:
+            status |= TW_BUS_ERROR;
+            break;
+        }
+    }
+
+    TWSR = status;
+    s_twi_busy = true;
+}
+
+
+const HostBusStruct& HostGetBus(void)
+{
+    return s_bus;
+}
+
+
+void HostSetSquareWaveWired(const bool wired)
+{
+    s_rtc_wired = wired;
+}
+
+
+void HostSetBusFault(const uint64_t begin_ms, const uint64_t end_ms)
+{
+    s_bus_fault_begin = begin_ms * 1000;
+    s_bus_fault_end = end_ms * 1000;
+}
+
+
+void HostBusTransaction(const uint8_t bytes)
+{
+    s_bus.transactions++;
+    s_bus.bytes += bytes;
+}
+
+//---------------------------------------------------------------------
+// USART0 model
+//---------------------------------------------------------------------
+
+static uint64_t UartByteMicros(void)
+{
+    // Start, 8 data and stop bit of 8 (U2X0) or 16 clocks each
+    uint32_t clocks = ((UCSR0A & _BV(U2X0)) ? 8 : 16) * (UBRR0 + 1UL) * 10;
+    return ((clocks + 8) / (F_CPU / 1000000));
+}
+
+
+static uint8_t UartStatusRead(const uint8_t value)
+{
+    return ((value & (_BV(U2X0) | _BV(MPCM0))) | (s_uart_rxc ? _BV(RXC0) : 0) | (s_uart_txc ? _BV(TXC0) : 0)
+            | (s_uart_udr_full ? 0 : _BV(UDRE0)) | (s_uart_dor ? _BV(DOR0) : 0));
+}
+
+
+static void UartStatusWrite(const uint8_t, const uint8_t value)
+{
+    // TXC0 is cleared by writing one
+    if (value & _BV(TXC0))
+    {
+        s_uart_txc = false;
+    }
+}
+
+
+static uint8_t UartDataRead(const uint8_t)
+{
+    s_uart_rxc = false;
+    s_uart_dor = false;
+    return s_uart_rdr;
+}
+
+
+static void UartDataWrite(const uint8_t, const uint8_t value)
+{
+    if (!(UCSR0B & _BV(TXEN0)))
+    {
+        return;
+    }
+
+    if (s_uart_tx_busy)
+    {
+        s_uart_udr = value;
+        s_uart_udr_full = true;
+        return;
+    }
+
+    // Empty shift register loads immediately
+    s_uart_tx_shift = value;
+    s_uart_tx_busy = true;
+    s_uart_tx_done = s_now + UartByteMicros();
+}
+
+
+static void CompleteUartReceive(void)
+{
+    uint8_t data = s_uart_line.front();
+    s_uart_line.pop_front();
+
+    if (s_uart_rxc)
+    {
+        s_uart_dor = true; // Firmware did not read UDR0 in time - byte lost
+    }
+    else
+    {
+        s_uart_rdr = data;
+        s_uart_rxc = true;
+    }
+
+    s_uart_rx_busy = !s_uart_line.empty();
+    s_uart_rx_done = s_now + UartByteMicros();
+}
+
+
+static void CompleteUartTransmit(void)
+{
+    if (write(s_uart_fd, &s_uart_tx_shift, 1) != 1)
+    {
+        // Client not reading - byte lost as on an unconnected line
+    }
+
+    if (s_uart_udr_full)
+    {
+        s_uart_tx_shift = s_uart_udr;
+        s_uart_udr_full = false;
+        s_uart_tx_done = s_now + UartByteMicros();
+    }
+    else
+    {
+        s_uart_tx_busy = false;
+        s_uart_txc = true;
+    }
+}
+
+
+// Every simulated millisecond while the pseudo terminal is open
+static void PollUart(void)
+{
+    uint8_t buffer[64];
+    ssize_t count = read(s_uart_fd, buffer, sizeof(buffer));
+
+    // USART clock halts in power-down - bytes are lost, the start bit only changes RXD
+    if ((count > 0) && !s_power_down && (UCSR0B & _BV(RXEN0)))
+    {
+        s_uart_line.insert(s_uart_line.end(), buffer, (buffer + count));
+    }
+    else if ((count > 0) && s_power_down && (PCICR & _BV(PCIE2)) && (PCMSK2 & _BV(PCINT16)))
+    {
+        s_pcint2_pending = true;
+    }
+
+    if (!s_uart_rx_busy && !s_uart_line.empty())
+    {
+        s_uart_rx_busy = true;
+        s_uart_rx_done = s_now + UartByteMicros();
+    }
+
+    // Hold simulated time to scaled wall-clock time - sleep overshoot is scaled too, so spin the last part
+    std::chrono::steady_clock::time_point due = s_uart_epoch + std::chrono::microseconds((uint64_t)(s_now / s_uart_rate));
+    std::chrono::steady_clock::duration ahead = (due - std::chrono::steady_clock::now());
+
+    if (ahead > std::chrono::milliseconds(2))
+    {
+        std::this_thread::sleep_for(ahead - std::chrono::milliseconds(1));
+    }
+
+    while (std::chrono::steady_clock::now() < due)
+    {
+        // spin
+    }
+}
+
+
+const char* HostOpenUart(const double rate)
+{
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if ((fd < 0) || grantpt(fd) || unlockpt(fd))
+    {
+        return nullptr;
+    }
+
+    const char* name = ptsname(fd);
+    int slave = open(name, O_RDWR | O_NOCTTY);
+    termios attributes;
+
+    if ((slave < 0) || tcgetattr(slave, &attributes))
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    // Binary frames - no echo or line editing
+    cfmakeraw(&attributes);
+    tcsetattr(slave, TCSANOW, &attributes);
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+
+    s_uart_fd = fd;
+    s_uart_slave = slave;
+    s_uart_poll_next = s_now;
+    s_uart_rate = rate;
+    s_uart_epoch = std::chrono::steady_clock::now() - std::chrono::microseconds((uint64_t)(s_now / rate));
+    return name;
+}
+
+//---------------------------------------------------------------------
+// Sleep
+//---------------------------------------------------------------------
+
+void set_sleep_mode(const uint8_t mode)
+{
+    s_sleep_mode = mode;
+}
+
+
+void sleep_enable(void)
+{
+    s_sleep_enabled = true;
+}
+
+
+void sleep_disable(void)
+{
+    s_sleep_enabled = false;
+}
+
+
+void sleep_cpu(void)
+{
+    if (!s_sleep_enabled || s_in_interrupt)
+    {
+        return;
+    }
+
+    uint32_t count = s_interrupt_count;
+    uint64_t begin = s_now;
+
+    // Timers halt in power-down; only pin changes and inputs wake
+    s_power_down = (s_sleep_mode == SLEEP_MODE_PWR_DOWN);
+
+    while (s_interrupt_count == count)
+    {
+        HostAdvance(s_power_down ? 1000 : 100);
+    }
+
+    if (s_power_down)
+    {
+        s_power.power_down += (s_now - begin);
+        s_power_down = false;
+        s_timer0_next = std::max(s_timer0_next, s_now + TIMER0_PERIOD);
+    }
+    else
+    {
+        s_power.idle += (s_now - begin);
+    }
+
+    s_power.wakeups++;
+}
+
+
+const HostPowerStruct& HostGetPower(void)
+{
+    s_power.active = s_now - s_power.idle - s_power.power_down;
+    return s_power;
+}
+
+//---------------------------------------------------------------------
+// Arduino core
+//---------------------------------------------------------------------
+
+void pinMode(uint8_t, uint8_t)
+{
+    // empty
+}
+
+
+void digitalWrite(uint8_t, uint8_t)
+{
+    // empty
+}
+
+
+int digitalRead(uint8_t)
+{
+    return LOW;
+}
+
+
+int analogRead(uint8_t pin)
+{
+    HostAdvance(110); // Conversion time
+    return s_analog[(pin >= A0) ? (pin - A0) : pin];
+}
+
+
+unsigned long millis(void)
+{
+    return (unsigned long)(s_now / 1000);
+}
+
+
+unsigned long micros(void)
+{
+    return (unsigned long)s_now;
+}
+
+
+void delay(unsigned long ms)
+{
+    uint64_t end = s_now + (ms * 1000);
+
+    while (s_now < end)
+    {
+        yield();
+        HostAdvance(std::min<uint64_t>(1000, end - s_now));
+    }
+}
+
+
+void delayMicroseconds(unsigned int us)
+{
+    HostAdvance(us);
+}
+
+
+void yield(void) __attribute__((weak));
+void yield(void)
+{
+    // empty
+}
+
+
+long random(long max)
+{
+    return (max > 0) ? (rand() % max) : 0;
+}
+
+
+long random(long min, long max)
+{
+    return (max > min) ? (min + (rand() % (max - min))) : min;
+}
+
+
+void randomSeed(unsigned long seed)
+{
+    srand(seed);
+}
+
+
+void sei(void)
+{
+    SREG |= _BV(SREG_I);
+}
+
+
+void cli(void)
+{
+    SREG &= ~_BV(SREG_I);
+}
+
+//---------------------------------------------------------------------
+// Watchdog
+//---------------------------------------------------------------------
+
+void wdt_enable(const uint8_t timeout)
+{
+    WDTCSR = (_BV(WDE) | timeout); // WDIE cleared as by avr-libc
+    s_wdt_enabled = true;
+    s_wdt_timeout = (15000ULL << timeout);
+    s_wdt_feed = s_now;
+}
+
+
+void wdt_disable(void)
+{
+    WDTCSR = 0;
+    s_wdt_enabled = false;
+}
+
+
+void wdt_reset(void)
+{
+    s_wdt_feed = s_now;
+}
+
+//---------------------------------------------------------------------
+// EEPROM
+//---------------------------------------------------------------------
+
+static uint8_t* EEPROM(void)
+{
+    if (!s_eeprom_init)
+    {
+        memset(s_eeprom, 0xFF, sizeof(s_eeprom)); // Erased state
+        s_eeprom_init = true;
+    }
+
+    return s_eeprom;
+}
+
+
+static uint8_t EepromControlRead(const uint8_t value)
+{
+    // EERE and EEMPE clear within four cycles
+    return (value & ~(_BV(EERE) | _BV(EEMPE) | _BV(EEPE))) | (s_eeprom_busy ? _BV(EEPE) : 0);
+}
+
+
+static void EepromControlWrite(const uint8_t previous, const uint8_t value)
+{
+    uint16_t address = (EEAR & E2END);
+
+    if ((value & _BV(EERE)) && !s_eeprom_busy)
+    {
+        EEDR = EEPROM()[address];
+    }
+
+    if ((value & _BV(EEPE)) && (previous & _BV(EEMPE)) && !s_eeprom_busy)
+    {
+        EEPROM()[address] = EEDR;
+        s_eeprom_busy = true;
+        s_eeprom_done = s_now + 3400; // Erase and write
+        s_eeprom_statistics.writes++;
+        s_eeprom_statistics.wear_max = std::max<uint32_t>(s_eeprom_statistics.wear_max, ++s_eeprom_wear[address]);
+    }
+}
+
+
+const HostEepromStruct& HostGetEeprom(void)
+{
+    return s_eeprom_statistics;
+}
+
+
+bool HostLoadEeprom(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    bool result = (fread(EEPROM(), 1, E2END + 1, file) == (E2END + 1));
+    fclose(file);
+    return result;
+}
+
+
+bool HostSaveEeprom(const char* path)
+{
+    FILE* file = fopen(path, "wb");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    bool result = (fwrite(EEPROM(), 1, E2END + 1, file) == (E2END + 1));
+    fclose(file);
+    return result;
+}
+
+
+bool eeprom_is_ready(void)
+{
+    return !s_eeprom_busy;
+}
+
+
+uint8_t eeprom_read_byte(const uint8_t* address)
+{
+    return EEPROM()[(uintptr_t)address & E2END];
+}
+
+
+void eeprom_write_byte(uint8_t* address, const uint8_t value)
+{
+    EEPROM()[(uintptr_t)address & E2END] = value;
+}
+
+
+void eeprom_update_byte(uint8_t* address, const uint8_t value)
+{
+    eeprom_write_byte(address, value);
+}
+
+
+void eeprom_read_block(void* destination, const void* source, size_t size)
+{
+    for (size_t index = 0; index < size; index++)
+    {
+        static_cast<uint8_t*>(destination)[index] = eeprom_read_byte((const uint8_t*)source + index);
+    }
+}
+
+
+void eeprom_update_block(const void* source, void* destination, size_t size)
+{
+    for (size_t index = 0; index < size; index++)
+    {
+        eeprom_update_byte((uint8_t*)destination + index, static_cast<const uint8_t*>(source)[index]);
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Host.h
+ * @summary     Host simulation interface for the B7971-Nixie-Clock firmware
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _HOST_H
+#define _HOST_H
+
+#include <stdint.h>
+
+const uint8_t HOST_TUBE_COUNT = 6;
+
+// Thrown from the virtual clock when the simulation limit is reached
+struct HostStop
+{
+    // empty
+};
+
+struct HostChainStruct
+{
+    uint16_t latched[HOST_TUBE_COUNT];  // Segment words currently driven
+    uint64_t on_time[HOST_TUBE_COUNT];  // Microseconds with any segment lit
+    uint32_t shift_count;               // Clock pulses received
+    uint32_t latch_count;               // Latch pulses received
+    uint64_t window_begin;              // Start of on_time accumulation
+};
+
+// Virtual clock
+uint64_t HostMicros(void);
+void HostAdvance(const uint64_t us);
+void HostSetLimit(const uint64_t us);
+
+// Scripted input
+enum class HostInput : uint8_t
+{
+    CW,
+    CCW,
+    PRESS,
+    RELEASE,
+};
+
+void HostScheduleInput(const uint64_t ms, const HostInput input);
+
+// Analog inputs
+void HostSetAnalog(const uint8_t channel, const uint16_t value);
+void HostSetAnalogNoise(const uint16_t noise); // Uniform deviation added to each conversion
+
+// Serial HV5622 chain model
+const HostChainStruct& HostGetChain(void);
+void HostResetChainStatistics(void);
+
+// Calendar
+void HostSetClock(const uint8_t year, const uint8_t month, const uint8_t day,
+                  const uint8_t hour, const uint8_t minute, const uint8_t second);
+void HostSetRTCDrift(const double ppm); // Oscillator error before the aging correction
+double HostGetRTCError(void); // Remaining error in ppm with the aging register applied
+
+// DS3232 register model - INT/SQW output wired to PC1 (A1)
+const uint8_t HOST_DS3232_ADDRESS = 0x68;
+
+uint8_t HostDS3232Read(const uint8_t reg);
+void HostDS3232Write(const uint8_t reg, const uint8_t value);
+bool HostDS3232Pin(void);
+void HostSetSquareWaveWired(const bool wired); // False leaves A1 unconnected, as on the original board
+uint64_t HostDS3232NextEdge(void);
+bool HostLoadDS3232Sram(const char* path);
+bool HostSaveDS3232Sram(const char* path);
+
+// Two-wire bus traffic
+struct HostBusStruct
+{
+    uint32_t transactions;  // START to STOP sequences
+    uint32_t bytes;         // Bytes transferred, including addresses
+};
+
+const HostBusStruct& HostGetBus(void);
+void HostBusTransaction(const uint8_t bytes);
+void HostSetBusFault(const uint64_t begin_ms, const uint64_t end_ms); // Slave stops responding
+
+// Sleep statistics
+struct HostPowerStruct
+{
+    uint64_t active;        // Microseconds awake
+    uint64_t idle;          // Microseconds in SLEEP_MODE_IDLE
+    uint64_t power_down;    // Microseconds in SLEEP_MODE_PWR_DOWN
+    uint32_t wakeups;       // Returns from sleep_cpu()
+};
+
+const HostPowerStruct& HostGetPower(void);
+
+// EEPROM programming
+struct HostEepromStruct
+{
+    uint32_t writes;        // Cells programmed through EECR
+    uint32_t wear_max;      // Most programming cycles of any cell
+};
+
+const HostEepromStruct& HostGetEeprom(void);
+bool HostLoadEeprom(const char* path);
+bool HostSaveEeprom(const char* path);
+
+// USART0 on a pseudo terminal - returns its name, simulation then runs at rate times real time
+const char* HostOpenUart(const double rate);
+
+#endif
@@ -0,0 +1,809 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Library.cpp
+ * @summary     Host implementations of the nDisplay, nCoder and nAudio libraries and the DS3232
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include <Arduino.h>
+#include <cmath>
+#include <nDisplay.h>
+#include <nCoder.h>
+#include <nAudio.h>
+#include "../B7971-Nixie-Clock/DS3232.h"
+#include "Host.h"
+
+extern CNcoder g_encoder;
+
+const uint32_t HOST_PROMPT_POLL_MS = 10; // Prompt timeout unit
+const uint8_t HOST_INPUT_POLL_US = 4;    // Cost of one input query
+
+bool g_host_trace = false;
+
+//---------------------------------------------------------------------
+// CDisplay
+//---------------------------------------------------------------------
+
+CDisplay::CDisplay(const uint8_t count)
+: m_count((count > MAX_UNITS) ? MAX_UNITS : count)
+, m_is_increment(nullptr)
+, m_is_select(nullptr)
+, m_is_update(nullptr)
+{
+    memset(m_value, ' ', sizeof(m_value));
+    memset(m_indicator, 0, sizeof(m_indicator));
+
+    for (uint8_t unit = 0; unit < MAX_UNITS; unit++)
+    {
+        m_brightness[unit] = Brightness::MAX;
+    }
+}
+
+
+void CDisplay::SetCallbackIsIncrement(CallbackInput callback)
+{
+    m_is_increment = callback;
+}
+
+
+void CDisplay::SetCallbackIsSelect(CallbackInput callback)
+{
+    m_is_select = callback;
+}
+
+
+void CDisplay::SetCallbackIsUpdate(CallbackInput callback)
+{
+    m_is_update = callback;
+}
+
+
+static void Trace(const uint8_t* value, const uint8_t count)
+{
+    static char previous[CDisplay::MAX_UNITS + 1];
+    char s[CDisplay::MAX_UNITS + 1];
+
+    for (uint8_t unit = 0; unit < count; unit++)
+    {
+        s[unit] = ((value[unit] >= ' ') && (value[unit] < 127)) ? value[unit] : '#';
+    }
+
+    s[count] = '\0';
+
+    if (g_host_trace && strcmp(s, previous))
+    {
+        printf("[%10.3f] |%s|\n", HostMicros() / 1e6, s);
+        strcpy(previous, s);
+    }
+}
+
+
+void CDisplay::SetDisplayValue(const char* s)
+{
+    bool end = false;
+
+    for (uint8_t unit = 0; unit < m_count; unit++)
+    {
+        end = end || (s[unit] == '\0');
+        m_value[unit] = end ? ' ' : s[unit];
+    }
+
+    Trace(m_value, m_count);
+}
+
+
+void CDisplay::SetDisplayValue(const __FlashStringHelper* s)
+{
+    SetDisplayValue(reinterpret_cast<const char*>(s));
+}
+
+
+void CDisplay::SetDisplayValue(const uint32_t value)
+{
+    uint32_t remainder = value;
+
+    for (uint8_t unit = m_count; unit-- > 0;)
+    {
+        m_value[unit] = '0' + (remainder % 10);
+        remainder /= 10;
+    }
+
+    Trace(m_value, m_count);
+}
+
+
+void CDisplay::SetDisplayBrightness(const Brightness brightness)
+{
+    for (uint8_t unit = 0; unit < m_count; unit++)
+    {
+        m_brightness[unit] = brightness;
+    }
+}
+
+
+void CDisplay::SetDisplayIndicator(const bool state)
+{
+    for (uint8_t unit = 0; unit < m_count; unit++)
+    {
+        m_indicator[unit] = state;
+    }
+}
+
+
+void CDisplay::SetUnitValue(const uint8_t unit, const uint8_t value)
+{
+    m_value[unit] = value;
+    Trace(m_value, m_count);
+}
+
+
+void CDisplay::SetUnitBrightness(const uint8_t unit, const Brightness brightness)
+{
+    m_brightness[unit] = brightness;
+}
+
+
+void CDisplay::SetUnitIndicator(const uint8_t unit, const bool state)
+{
+    m_indicator[unit] = state;
+}
+
+
+void CDisplay::EffectScroll(const char* s, const Direction direction, const uint16_t delay_ms)
+{
+    uint8_t length = strlen(s);
+
+    for (uint8_t index = 0; index < length; index++)
+    {
+        if (direction == Direction::LEFT)
+        {
+            memmove(&m_value[0], &m_value[1], m_count - 1);
+            m_value[m_count - 1] = s[index];
+        }
+        else
+        {
+            memmove(&m_value[1], &m_value[0], m_count - 1);
+            m_value[0] = s[length - index - 1];
+        }
+
+        Trace(m_value, m_count);
+        delay(delay_ms);
+    }
+}
+
+
+void CDisplay::EffectScroll(const __FlashStringHelper* s, const Direction direction, const uint16_t delay_ms)
+{
+    EffectScroll(reinterpret_cast<const char*>(s), direction, delay_ms);
+}
+
+
+void CDisplay::EffectSlotMachine(const uint8_t cycles)
+{
+    uint8_t target[MAX_UNITS];
+    memcpy(target, m_value, sizeof(target));
+
+    for (uint8_t cycle = 0; cycle < cycles; cycle++)
+    {
+        for (uint8_t unit = 0; unit < m_count; unit++)
+        {
+            // Units settle from left to right
+            if (cycle < (cycles - (m_count - unit)))
+            {
+                m_value[unit] = '0' + ((target[unit] + cycle) % 10);
+            }
+            else
+            {
+                m_value[unit] = target[unit];
+            }
+        }
+
+        delay(20);
+    }
+
+    memcpy(m_value, target, sizeof(target));
+    Trace(m_value, m_count);
+}
+
+
+void CDisplay::ShowTitle(const __FlashStringHelper* title)
+{
+    if (title)
+    {
+        SetDisplayValue(title);
+        delay(500);
+    }
+}
+
+
+bool CDisplay::WaitRelease(void)
+{
+    while (m_is_select && m_is_select())
+    {
+        delay(HOST_PROMPT_POLL_MS);
+    }
+
+    return true;
+}
+
+
+int8_t CDisplay::PromptSelect(PromptSelectStruct& prompt, const uint32_t timeout, CallbackEvent callback)
+{
+    uint8_t selection = (prompt.initial_selection < prompt.item_count) ? prompt.initial_selection : 0;
+    uint32_t counter = timeout;
+
+    ShowTitle(prompt.title);
+    SetDisplayValue(prompt.item_array[selection]);
+
+    while (true)
+    {
+        if (m_is_update && m_is_update())
+        {
+            Event event;
+
+            if (m_is_increment && m_is_increment())
+            {
+                selection = (selection + 1) % prompt.item_count;
+                event = Event::INCREMENT;
+            }
+            else
+            {
+                selection = (selection + prompt.item_count - 1) % prompt.item_count;
+                event = Event::DECREMENT;
+            }
+
+            SetDisplayValue(prompt.item_array[selection]);
+
+            if (callback)
+            {
+                callback(event, selection);
+            }
+
+            counter = timeout;
+        }
+
+        if (m_is_select && m_is_select())
+        {
+            WaitRelease();
+
+            if (callback)
+            {
+                callback(Event::SELECTION, selection);
+            }
+
+            return selection;
+        }
+
+        delay(HOST_PROMPT_POLL_MS);
+
+        if (--counter == 0)
+        {
+            if (callback && callback(Event::TIMEOUT, selection))
+            {
+                counter = timeout;
+                continue;
+            }
+
+            return -1;
+        }
+    }
+}
+
+
+int8_t CDisplay::PromptValue(PromptValueStruct& prompt, const uint32_t timeout, CallbackEvent callback)
+{
+    uint32_t counter = timeout;
+
+    ShowTitle(prompt.title);
+
+    if (prompt.initial_display)
+    {
+        SetDisplayValue(prompt.initial_display);
+    }
+
+    for (uint8_t item = 0; item < prompt.item_count; item++)
+    {
+        while (true)
+        {
+            if (m_is_update && m_is_update())
+            {
+                Event event;
+                type_item& value = prompt.item_value[item];
+
+                if (m_is_increment && m_is_increment())
+                {
+                    value = (value >= prompt.item_upper_limit[item]) ? prompt.item_lower_limit[item] : value + 1;
+                    event = Event::INCREMENT;
+                }
+                else
+                {
+                    value = (value <= prompt.item_lower_limit[item]) ? prompt.item_upper_limit[item] : value - 1;
+                    event = Event::DECREMENT;
+                }
+
+                uint8_t position = prompt.item_position[item];
+
+                if (prompt.alphabetic)
+                {
+                    m_value[position] = value;
+                }
+                else
+                {
+                    uint8_t remainder = value;
+
+                    for (uint8_t digit = prompt.item_digit_count[item]; digit-- > 0;)
+                    {
+                        m_value[position + digit] = '0' + (remainder % 10);
+                        remainder /= 10;
+                    }
+                }
+
+                Trace(m_value, m_count);
+
+                if (callback)
+                {
+                    callback(event, value);
+                }
+
+                counter = timeout;
+            }
+
+            if (m_is_select && m_is_select())
+            {
+                WaitRelease();
+                break;
+            }
+
+            delay(HOST_PROMPT_POLL_MS);
+
+            if (--counter == 0)
+            {
+                if (callback && callback(Event::TIMEOUT, prompt.item_value[item]))
+                {
+                    counter = timeout;
+                    continue;
+                }
+
+                return -1;
+            }
+        }
+    }
+
+    if (callback)
+    {
+        callback(Event::SELECTION, prompt.item_value[prompt.item_count - 1]);
+    }
+
+    return 0;
+}
+
+//---------------------------------------------------------------------
+// CNcoder
+//---------------------------------------------------------------------
+
+CNcoder::CNcoder(const uint8_t, const ButtonMode, const RotationMode)
+: m_callback(nullptr)
+, m_rotation(Rotation::CW)
+, m_button(Button::UP)
+, m_pending(0)
+{
+    // empty
+}
+
+
+bool CNcoder::IsUpdateAvailable(void)
+{
+    HostAdvance(HOST_INPUT_POLL_US);
+
+    if (m_pending)
+    {
+        m_pending--;
+        return true;
+    }
+
+    return false;
+}
+
+
+void CNcoder::HostRotate(const Rotation rotation)
+{
+    m_rotation = rotation;
+    m_pending++;
+
+    if (m_callback)
+    {
+        m_callback();
+    }
+}
+
+
+void CNcoder::HostButton(const Button button)
+{
+    m_button = button;
+}
+
+
+void HostDispatchInput(const HostInput input)
+{
+    switch (input)
+    {
+    case HostInput::CW:
+        g_encoder.HostRotate(CNcoder::Rotation::CW);
+        break;
+    case HostInput::CCW:
+        g_encoder.HostRotate(CNcoder::Rotation::CCW);
+        break;
+    case HostInput::PRESS:
+        g_encoder.HostButton(CNcoder::Button::DOWN);
+        break;
+    case HostInput::RELEASE:
+        g_encoder.HostButton(CNcoder::Button::UP);
+        break;
+    }
+}
+
+//---------------------------------------------------------------------
+// CAudio
+//---------------------------------------------------------------------
+
+CAudio::CAudio(const uint8_t, const uint8_t, const uint8_t)
+: m_end(0)
+{
+    // empty
+}
+
+
+void CAudio::Play(const Functions, const uint8_t* a, const uint8_t*, const uint8_t*)
+{
+    uint16_t tokens = 0;
+
+    while (a[tokens + 1] != END)
+    {
+        tokens++;
+    }
+
+    m_end = millis() + (tokens * 60UL);
+}
+
+
+void CAudio::Stop(void)
+{
+    m_end = 0;
+}
+
+
+bool CAudio::IsActive(void) const
+{
+    return (millis() < m_end);
+}
+
+//---------------------------------------------------------------------
+// Calendar
+//---------------------------------------------------------------------
+
+// Oscillator - clock microseconds advance at s_rtc_rate per virtual microsecond
+static int64_t s_rtc_origin = 0;            // Clock microseconds since 2000-01-01 at s_rtc_origin_us
+static uint64_t s_rtc_origin_us = 0;
+static double s_rtc_drift = 0.0;            // Crystal error in ppm before the aging correction
+static double s_rtc_rate = 1.0;
+
+
+static int32_t DaysFromCivil(int32_t year, const uint8_t month, const uint8_t day)
+{
+    year -= (month <= 2);
+    const int32_t era = year / 400;
+    const uint32_t yoe = year - (era * 400);
+    const uint32_t doy = ((153 * (month + ((month > 2) ? -3 : 9))) + 2) / 5 + day - 1;
+    const uint32_t doe = (yoe * 365) + (yoe / 4) - (yoe / 100) + doy;
+    return (era * 146097) + doe - 730425; // Relative to 2000-01-01
+}
+
+
+static void CivilFromDays(int32_t days, uint8_t& year, uint8_t& month, uint8_t& day)
+{
+    days += 730425; // Relative to 0000-03-01
+    const int32_t era = days / 146097;
+    const uint32_t doe = days - (era * 146097);
+    const uint32_t yoe = (doe - (doe / 1460) + (doe / 36524) - (doe / 146096)) / 365;
+    const uint32_t doy = doe - ((365 * yoe) + (yoe / 4) - (yoe / 100));
+    const uint32_t mp = ((5 * doy) + 2) / 153;
+    day = doy - (((153 * mp) + 2) / 5) + 1;
+    month = (mp < 10) ? (mp + 3) : (mp - 9);
+    year = (yoe + (era * 400) + (month <= 2)) - 2000;
+}
+
+
+static int64_t RTCMicros(void)
+{
+    return s_rtc_origin + (int64_t)floor((double)(HostMicros() - s_rtc_origin_us) * s_rtc_rate);
+}
+
+
+static int64_t RTCSeconds(void)
+{
+    return (RTCMicros() / 1000000);
+}
+
+
+// Writing the seconds register restarts the countdown to the next second
+static void SetClock(const uint8_t year, const uint8_t month, const uint8_t day,
+                     const uint8_t hour, const uint8_t minute, const uint8_t second, const bool restart)
+{
+    int64_t target = ((int64_t)DaysFromCivil(2000 + year, month, day) * 86400)
+                   + (hour * 3600) + (minute * 60) + second;
+    int64_t fraction = restart ? 0 : (RTCMicros() % 1000000);
+    s_rtc_origin = (target * 1000000) + fraction;
+    s_rtc_origin_us = HostMicros();
+}
+
+
+void HostSetClock(const uint8_t year, const uint8_t month, const uint8_t day,
+                  const uint8_t hour, const uint8_t minute, const uint8_t second)
+{
+    SetClock(year, month, day, hour, minute, second, false);
+}
+
+
+static void ClockFieldsAt(const int64_t seconds, CRTC::RTC& rtc)
+{
+    int32_t days = seconds / 86400;
+    uint32_t time = seconds % 86400;
+
+    CivilFromDays(days, rtc.year, rtc.month, rtc.day);
+    rtc.week_day = ((days + 6) % 7) + 1; // 2000-01-01 was a Saturday, Sunday = 1
+    rtc.hour = time / 3600;
+    rtc.minute = (time / 60) % 60;
+    rtc.second = time % 60;
+    rtc.am = (rtc.hour < 12);
+}
+
+
+static void ClockFields(CRTC::RTC& rtc)
+{
+    ClockFieldsAt(RTCSeconds(), rtc);
+}
+
+//---------------------------------------------------------------------
+// DS3232 registers
+//---------------------------------------------------------------------
+
+static uint8_t s_ds3232[256];
+static int64_t s_alarm_seconds = -1; // Last second compared against the alarms
+
+
+// Positive aging adds load capacitance and slows the oscillator by 0.1ppm per LSB
+static void UpdateRate(void)
+{
+    s_rtc_origin = RTCMicros();
+    s_rtc_origin_us = HostMicros();
+    s_rtc_rate = 1.0 + ((s_rtc_drift - (0.1 * (int8_t)s_ds3232[DS3232_REGISTER_AGING])) / 1000000.0);
+}
+
+
+void HostSetRTCDrift(const double ppm)
+{
+    s_rtc_drift = ppm;
+    UpdateRate();
+}
+
+
+double HostGetRTCError(void)
+{
+    return ((s_rtc_rate - 1.0) * 1000000.0);
+}
+
+
+static void ResetDS3232(void)
+{
+    static bool reset = false;
+
+    if (!reset)
+    {
+        s_ds3232[DS3232_REGISTER_CONTROL] = 0x1C; // INTCN set, RS2:RS1 = 8.192kHz
+        s_ds3232[DS3232_REGISTER_STATUS] = 0x88; // OSF and EN32kHz set at power-on
+        s_ds3232[DS3232_REGISTER_TEMPERATURE] = 22;
+        s_ds3232[DS3232_REGISTER_TEMPERATURE + 1] = 0x40;
+        reset = true;
+    }
+}
+
+
+static uint8_t ToBCD(const uint8_t value)
+{
+    return ((value / 10) << 4) | (value % 10);
+}
+
+
+static uint8_t FromBCD(const uint8_t value)
+{
+    return ((value >> 4) * 10) + (value & 0x0F);
+}
+
+
+// Compare alarm registers (bit 7 masks a field) against the clock
+static bool AlarmMatch(const uint8_t* alarm, const uint8_t second, const CRTC::RTC& rtc)
+{
+    const uint8_t field[] = {second, rtc.minute, rtc.hour};
+
+    for (uint8_t index = 0; index < 3; index++)
+    {
+        if (!(alarm[index] & 0x80) && (FromBCD(alarm[index] & 0x7F) != field[index]))
+        {
+            return false;
+        }
+    }
+
+    uint8_t daydate = alarm[3];
+
+    if (daydate & 0x80)
+    {
+        return true;
+    }
+
+    return (daydate & _BV(DS3232_ALARM_DYDT)) ? ((daydate & 0x0F) == rtc.week_day)
+                                              : (FromBCD(daydate & 0x3F) == rtc.day);
+}
+
+
+// Raise A1F/A2F for every second elapsed since the previous call
+static void UpdateAlarms(void)
+{
+    int64_t now = RTCSeconds();
+
+    if ((s_alarm_seconds < 0) || (now < s_alarm_seconds))
+    {
+        s_alarm_seconds = now; // Clock set - resume matching from here
+        return;
+    }
+
+    while (s_alarm_seconds < now)
+    {
+        CRTC::RTC rtc;
+        ClockFieldsAt(++s_alarm_seconds, rtc);
+
+        // Alarm 1 is seconds, minutes, hours, day/date - Alarm 2 matches at second 00
+        const uint8_t* alarm1 = &s_ds3232[DS3232_REGISTER_ALARM1];
+        const uint8_t* alarm2 = &s_ds3232[DS3232_REGISTER_ALARM2];
+        const uint8_t alarm2_fields[] = {0, alarm2[0], alarm2[1], alarm2[2]};
+
+        if (AlarmMatch(alarm1, rtc.second, rtc))
+        {
+            s_ds3232[DS3232_REGISTER_STATUS] |= _BV(DS3232_STATUS_A1F);
+        }
+
+        if ((rtc.second == 0) && AlarmMatch(alarm2_fields, 0, rtc))
+        {
+            s_ds3232[DS3232_REGISTER_STATUS] |= _BV(DS3232_STATUS_A2F);
+        }
+    }
+}
+
+
+uint8_t HostDS3232Read(const uint8_t reg)
+{
+    ResetDS3232();
+    UpdateAlarms();
+
+    if (reg > DS3232_REGISTER_YEAR)
+    {
+        return s_ds3232[reg];
+    }
+
+    CRTC::RTC rtc;
+    ClockFields(rtc);
+    const uint8_t field[] = {rtc.second, rtc.minute, rtc.hour, 0, rtc.day, rtc.month, rtc.year};
+    return (reg == DS3232_REGISTER_DAY) ? rtc.week_day : ToBCD(field[reg]);
+}
+
+
+void HostDS3232Write(const uint8_t reg, const uint8_t value)
+{
+    ResetDS3232();
+    UpdateAlarms();
+
+    if (reg == DS3232_REGISTER_STATUS)
+    {
+        // Alarm and oscillator flags can only be cleared
+        uint8_t flags = (_BV(DS3232_STATUS_A1F) | _BV(DS3232_STATUS_A2F) | _BV(DS3232_STATUS_OSF));
+        s_ds3232[reg] = ((value & ~flags) | (value & s_ds3232[reg] & flags));
+        return;
+    }
+
+    if (reg > DS3232_REGISTER_YEAR)
+    {
+        s_ds3232[reg] = value;
+
+        if (reg == DS3232_REGISTER_AGING)
+        {
+            UpdateRate(); // Device applies it at the next conversion
+        }
+
+        return;
+    }
+
+    CRTC::RTC rtc;
+    ClockFields(rtc);
+    uint8_t* field[] = {&rtc.second, &rtc.minute, &rtc.hour, &rtc.week_day, &rtc.day, &rtc.month, &rtc.year};
+    *field[reg] = (reg == DS3232_REGISTER_DAY) ? value : FromBCD(value & 0x7F);
+    SetClock(rtc.year, rtc.month, rtc.day, rtc.hour, rtc.minute, rtc.second, (reg == DS3232_REGISTER_SECONDS));
+    s_alarm_seconds = -1; // Skipped seconds never match
+}
+
+
+// Battery-backed SRAM (0x14-0xFF) kept between runs
+bool HostLoadDS3232Sram(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    size_t size = (sizeof(s_ds3232) - DS3232_REGISTER_SRAM);
+    bool result = (fread(&s_ds3232[DS3232_REGISTER_SRAM], 1, size, file) == size);
+    fclose(file);
+    return result;
+}
+
+
+bool HostSaveDS3232Sram(const char* path)
+{
+    FILE* file = fopen(path, "wb");
+
+    if (!file)
+    {
+        return false;
+    }
+
+    size_t size = (sizeof(s_ds3232) - DS3232_REGISTER_SRAM);
+    bool result = (fwrite(&s_ds3232[DS3232_REGISTER_SRAM], 1, size, file) == size);
+    fclose(file);
+    return result;
+}
+
+
+bool HostDS3232Pin(void)
+{
+    ResetDS3232();
+    UpdateAlarms();
+    uint8_t control = s_ds3232[DS3232_REGISTER_CONTROL];
+
+    if (control & _BV(DS3232_CONTROL_INTCN))
+    {
+        // Open drain pulled low while an enabled alarm flag is set
+        return !(control & s_ds3232[DS3232_REGISTER_STATUS] & (_BV(DS3232_STATUS_A1F) | _BV(DS3232_STATUS_A2F)));
+    }
+
+    // Only the 1Hz rate is modelled - falling edge as the seconds increment
+    uint8_t rate = (_BV(DS3232_CONTROL_RS1) | _BV(DS3232_CONTROL_RS2));
+    return ((control & rate) != 0) || ((RTCMicros() % 1000000) >= 500000);
+}
+
+
+// Virtual time of the next half second of the oscillator
+uint64_t HostDS3232NextEdge(void)
+{
+    int64_t boundary = (((RTCMicros() / 500000) + 1) * 500000);
+    return (s_rtc_origin_us + (uint64_t)ceil((double)(boundary - s_rtc_origin) / s_rtc_rate));
+}
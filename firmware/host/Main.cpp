@@ -0,0 +1,452 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Main.cpp
+ * @summary     Host runner and benchmarks for the B7971-Nixie-Clock firmware
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include <Arduino.h>
+#include <chrono>
+#include "Host.h"
+#include "../B7971-Nixie-Clock/B7971-Nixie-Clock.h"
+#include "../B7971-Nixie-Clock/Frame.h"
+#include "../B7971-Nixie-Clock/Twi.h"
+#include "../B7971-Nixie-Clock/Adc.h"
+#include "../B7971-Nixie-Clock/Journal.h"
+#include "../B7971-Nixie-Clock/Config.h"
+#include "../B7971-Nixie-Clock/Diagnostics.h"
+#include "../B7971-Nixie-Clock/Uart.h"
+#include "../B7971-Nixie-Clock/Discipline.h"
+#include "../B7971-Nixie-Clock/Supervisor.h"
+#include "../B7971-Nixie-Clock/Trace.h"
+
+extern bool g_host_trace;
+
+typedef std::chrono::steady_clock host_clock;
+
+
+static void Usage(const char* name)
+{
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "  --seconds N          simulated run time (default 60)\n"
+        "  --clock YYMMDDhhmmss initial RTC value\n"
+        "  --light N            photodiode ADC reading (0-1023)\n"
+        "  --battery N          battery ADC reading (0-1023)\n"
+        "  --adc-noise N        add up to +/-N LSB of noise to each conversion\n"
+        "  --input LIST         comma separated ms:event, event = cw|ccw|press|release\n"
+        "  --eeprom FILE        load EEPROM image from FILE and save it on exit\n"
+        "  --bus-fault MS:MS    DS3232 stops responding between the given times\n"
+        "  --uart [RATE]        connect USART0 to a pseudo terminal and run at RATE times real time\n"
+        "  --sqw-nc             leave DS3232 INT/SQW unconnected, as on the unmodified board\n"
+        "  --rtc-ppm X          DS3232 oscillator error in ppm (positive runs fast)\n"
+        "  --rtc-sram FILE      load DS3232 SRAM from FILE and save it on exit\n"
+        "  --mcusr N            reset flags seen at boot (default 1, power-on; 8 is watchdog)\n"
+        "  --trace              print display content changes\n"
+        "  --bench [N]          run hot path benchmarks for N iterations\n",
+        name);
+}
+
+
+static bool ParseInput(char* list)
+{
+    for (char* token = strtok(list, ","); token; token = strtok(nullptr, ","))
+    {
+        char* separator = strchr(token, ':');
+
+        if (!separator)
+        {
+            return false;
+        }
+
+        *separator++ = '\0';
+        uint64_t ms = strtoull(token, nullptr, 10);
+
+        if (!strcmp(separator, "cw"))
+        {
+            HostScheduleInput(ms, HostInput::CW);
+        }
+        else if (!strcmp(separator, "ccw"))
+        {
+            HostScheduleInput(ms, HostInput::CCW);
+        }
+        else if (!strcmp(separator, "press"))
+        {
+            HostScheduleInput(ms, HostInput::PRESS);
+        }
+        else if (!strcmp(separator, "release"))
+        {
+            HostScheduleInput(ms, HostInput::RELEASE);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+static bool ParseClock(const char* s)
+{
+    unsigned value[6];
+
+    if ((strlen(s) != 12) ||
+        (sscanf(s, "%2u%2u%2u%2u%2u%2u", &value[0], &value[1], &value[2],
+                &value[3], &value[4], &value[5]) != 6))
+    {
+        return false;
+    }
+
+    HostSetClock(value[0], value[1], value[2], value[3], value[4], value[5]);
+    return true;
+}
+
+
+template<typename T> static void Bench(const char* name, const uint32_t iterations, T function)
+{
+    host_clock::time_point begin = host_clock::now();
+
+    for (uint32_t index = 0; index < iterations; index++)
+    {
+        function(index);
+    }
+
+    double seconds = std::chrono::duration<double>(host_clock::now() - begin).count();
+    printf("bench %-24s %10u iterations %8.1f ns/op %12.0f op/s\n",
+           name, iterations, (seconds * 1e9) / iterations, iterations / seconds);
+}
+
+
+static void RunBenchmarks(const uint32_t iterations)
+{
+    volatile uint8_t sink = 0;
+    char s[DISPLAY_COUNT + 1];
+    CRTC::RTC rtc;
+
+    Bench("FormatRTCString/TIME", iterations, [&](uint32_t index)
+    {
+        rtc.hour = index % 24;
+        rtc.minute = index % 60;
+        rtc.second = (index >> 6) % 60;
+        FormatRTCString(rtc, s, RTCSelect::TIME);
+        sink += s[5];
+    });
+
+    Bench("FormatRTCString/DATE", iterations, [&](uint32_t index)
+    {
+        rtc.year = index % 100;
+        rtc.month = 1 + (index % 12);
+        rtc.day = 1 + (index % 31);
+        FormatRTCString(rtc, s, RTCSelect::DATE);
+        sink += s[5];
+    });
+
+    Bench("ReadLightIntensity", iterations, [&](uint32_t)
+    {
+        sink += getValue(ReadLightIntensity());
+    });
+
+    Bench("ReadBatteryMillivolts", iterations, [&](uint32_t)
+    {
+        sink += ReadBatteryMillivolts();
+    });
+}
+
+
+// Map a latched segment word back to the character it displays
+static char DecodeSegments(const uint16_t segments)
+{
+    uint16_t bitmap = (segments & ~0x0002); // Strip indicator
+
+    if (bitmap == 0)
+    {
+        return ' ';
+    }
+
+    for (uint8_t index = 0; index < (sizeof(BITMAP) / sizeof(BITMAP[0])); index++)
+    {
+        if (pgm_read_word_near(BITMAP + index) == bitmap)
+        {
+            return (24 + index);
+        }
+    }
+
+    return '?';
+}
+
+
+static void Report(const double simulated, const double wall)
+{
+    const HostChainStruct& chain = HostGetChain();
+    double window = (HostMicros() - chain.window_begin);
+
+    printf("simulated %.3f s in %.3f s wall (%.0fx real time)\n",
+           simulated, wall, (wall > 0) ? (simulated / wall) : 0.0);
+    printf("display latches %u, clocks %u, showing |", chain.latch_count, chain.shift_count);
+
+    for (uint8_t tube = 0; tube < HOST_TUBE_COUNT; tube++)
+    {
+        printf("%c", DecodeSegments(chain.latched[tube]));
+    }
+
+    printf("|\n");
+    FrameStatisticsStruct statistics;
+    GetFrameStatistics(statistics);
+    printf("sub-frames shifted %u, skipped %u\n", statistics.shifted, statistics.skipped);
+    printf("tube duty %%:");
+
+    for (uint8_t tube = 0; tube < HOST_TUBE_COUNT; tube++)
+    {
+        printf(" %5.1f", (window > 0) ? ((100.0 * chain.on_time[tube]) / window) : 0.0);
+    }
+
+    printf("\n");
+    const HostBusStruct& bus = HostGetBus();
+    printf("i2c transactions %u, bytes %u\n", bus.transactions, bus.bytes);
+    TwiStatisticsStruct twi;
+    GetTwiStatistics(twi);
+    printf("twi completed %u, failed %u, retries %u, recoveries %u, latency %u us (max %u us)\n",
+           twi.completed, twi.failed, twi.retries, twi.recoveries, twi.latency_last, twi.latency_max);
+    const HostEepromStruct& eeprom = HostGetEeprom();
+    JournalStatisticsStruct journal;
+    GetJournalStatistics(journal);
+    ConfigStatisticsStruct config;
+    GetConfigStatistics(config);
+    printf("eeprom records %u, cells programmed %u, most writes to one cell %u\n",
+           journal.records, eeprom.writes, eeprom.wear_max);
+    printf("config loaded version %u%s, record %u bytes\n",
+           config.loaded, config.migrated ? " (migrated)" : "", (unsigned)config.bytes);
+    const char* adc_name[ADC_CHANNELS] = {"light", "battery"};
+
+    for (uint8_t channel = 0; channel < ADC_CHANNELS; channel++)
+    {
+        AdcStatisticsStruct adc;
+        GetAdcStatistics(static_cast<AdcChannel>(channel), adc);
+        printf("adc %-7s value %u, rate %u/s, noise %.2f LSB rms, peak %u LSB\n",
+               adc_name[channel], adc.value, adc.rate, adc.noise / 16.0, adc.peak);
+    }
+
+    UartStatisticsStruct uart;
+    GetUartStatistics(uart);
+    printf("uart received %u, transmitted %u bytes, overruns %u, framing errors %u\n",
+           uart.received, uart.transmitted, uart.overruns, uart.errors);
+    DisciplineStatusStruct discipline;
+    GetDisciplineStatus(discipline);
+    printf("rtc aging %d, oscillator error %+.3f ppm, estimated drift %+.3f ppm, phase %+.3f ms\n",
+           discipline.aging, HostGetRTCError(), discipline.drift / 1000.0, discipline.phase / 1000.0);
+    printf("discipline updates %u, steps %u, samples %u, offset %+.3f ms%s\n",
+           discipline.updates, discipline.steps, discipline.samples, discipline.offset / 1000.0,
+           discipline.sqw ? "" : ", no SQW");
+    const char* task_name[getValue(SupervisorTask::COUNT) + 1] = {"loop", "display", "rtc", "menu", "none"};
+    SupervisorResetStruct log[SUPERVISOR_LOG_ENTRIES];
+    uint8_t resets = GetResetLog(log);
+    printf("supervisor stalled task %s, reset log", task_name[getValue(SupervisorStalled())]);
+
+    for (uint8_t index = 0; index < resets; index++)
+    {
+        char entry[DISPLAY_COUNT + 1];
+        FormatResetLog(entry, log[index]);
+        printf(" %s", entry);
+    }
+
+    printf("%s\n", resets ? "" : " empty");
+    TraceStatisticsStruct trace;
+    GetTraceStatistics(trace);
+    printf("trace recorded %u, bursts %u, dropped %u\n", trace.recorded, trace.bursts, trace.dropped);
+
+    const HostPowerStruct& power = HostGetPower();
+    double total = HostMicros();
+    printf("cpu %%: active %.1f, idle %.1f, power-down %.1f, wakeups %u\n",
+           (100.0 * power.active) / total, (100.0 * power.idle) / total,
+           (100.0 * power.power_down) / total, power.wakeups);
+
+#ifdef DIAGNOSTICS
+    DiagnosticsStruct diagnostics;
+    GetDiagnostics(diagnostics);
+    printf("diagnostics loop <1ms %u, <10ms %u, <100ms %u, >=100ms %u, longest %u us\n",
+           diagnostics.loop[0], diagnostics.loop[1], diagnostics.loop[2], diagnostics.loop[3],
+           diagnostics.longest);
+    printf("diagnostics longest blocking i2c %u us\n", diagnostics.block);
+    printf("diagnostics isr display %u calls (max %u ticks), tick %u calls (max %u ticks)\n",
+           diagnostics.isr[getValue(DiagnosticsIsr::DISPLAY)].count,
+           diagnostics.isr[getValue(DiagnosticsIsr::DISPLAY)].max,
+           diagnostics.isr[getValue(DiagnosticsIsr::TICK)].count,
+           diagnostics.isr[getValue(DiagnosticsIsr::TICK)].max);
+#endif
+}
+
+
+int main(int argc, char** argv)
+{
+    double seconds = 60;
+    uint32_t bench = 0;
+    const char* eeprom = nullptr;
+    const char* sram = nullptr;
+
+    for (int index = 1; index < argc; index++)
+    {
+        const char* option = argv[index];
+        const char* value = (index + 1 < argc) ? argv[index + 1] : nullptr;
+
+        if (!strcmp(option, "--seconds") && value)
+        {
+            seconds = atof(value);
+            index++;
+        }
+        else if (!strcmp(option, "--clock") && value && ParseClock(value))
+        {
+            index++;
+        }
+        else if (!strcmp(option, "--light") && value)
+        {
+            HostSetAnalog(ANALOG_PIN_PHOTODIODE - A0, atoi(value));
+            index++;
+        }
+        else if (!strcmp(option, "--battery") && value)
+        {
+            HostSetAnalog(ANALOG_PIN_BATTERY - A0, atoi(value));
+            index++;
+        }
+        else if (!strcmp(option, "--eeprom") && value)
+        {
+            eeprom = value;
+            HostLoadEeprom(eeprom);
+            index++;
+        }
+        else if (!strcmp(option, "--adc-noise") && value)
+        {
+            HostSetAnalogNoise(atoi(value));
+            index++;
+        }
+        else if (!strcmp(option, "--input") && value && ParseInput(argv[index + 1]))
+        {
+            index++;
+        }
+        else if (!strcmp(option, "--bus-fault") && value && strchr(value, ':'))
+        {
+            HostSetBusFault(strtoull(value, nullptr, 10), strtoull(strchr(value, ':') + 1, nullptr, 10));
+            index++;
+        }
+        else if (!strcmp(option, "--sqw-nc"))
+        {
+            HostSetSquareWaveWired(false);
+        }
+        else if (!strcmp(option, "--rtc-ppm") && value)
+        {
+            HostSetRTCDrift(atof(value));
+            index++;
+        }
+        else if (!strcmp(option, "--rtc-sram") && value)
+        {
+            sram = value;
+            HostLoadDS3232Sram(sram);
+            index++;
+        }
+        else if (!strcmp(option, "--mcusr") && value)
+        {
+            MCUSR = strtoul(value, nullptr, 0);
+            index++;
+        }
+        else if (!strcmp(option, "--uart"))
+        {
+            double rate = 1;
+
+            if (value && (value[0] != '-'))
+            {
+                rate = atof(value);
+                index++;
+            }
+
+            const char* name = (rate > 0) ? HostOpenUart(rate) : nullptr;
+
+            if (!name)
+            {
+                fprintf(stderr, "unable to open pseudo terminal\n");
+                return 1;
+            }
+
+            printf("uart %s\n", name);
+            fflush(stdout);
+        }
+        else if (!strcmp(option, "--trace"))
+        {
+            g_host_trace = true;
+        }
+        else if (!strcmp(option, "--bench"))
+        {
+            bench = 1000000;
+
+            if (value && (value[0] != '-'))
+            {
+                bench = strtoul(value, nullptr, 10);
+                index++;
+            }
+        }
+        else
+        {
+            Usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (bench)
+    {
+        RunBenchmarks(bench);
+        return 0;
+    }
+
+    host_clock::time_point begin = host_clock::now();
+    HostSetLimit((uint64_t)(seconds * 1e6));
+
+    try
+    {
+        setup();
+
+        while (true)
+        {
+            loop();
+        }
+    }
+    catch (const HostStop&)
+    {
+        // Simulation limit reached
+    }
+
+    Report(HostMicros() / 1e6, std::chrono::duration<double>(host_clock::now() - begin).count());
+
+    if (eeprom && !HostSaveEeprom(eeprom))
+    {
+        fprintf(stderr, "unable to write %s\n", eeprom);
+        return 1;
+    }
+
+    if (sram && !HostSaveDS3232Sram(sram))
+    {
+        fprintf(stderr, "unable to write %s\n", sram);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,752 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        Client.cpp
+ * @summary     Reference client for the B7971-Nixie-Clock serial protocol
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <termios.h>
+#include <algorithm>
+#include <util/crc16.h>
+#include "../../B7971-Nixie-Clock/Protocol.h"
+#include "../../B7971-Nixie-Clock/Discipline.h"
+#include "../../B7971-Nixie-Clock/Supervisor.h"
+#include "../../B7971-Nixie-Clock/Trace.h"
+
+const int CLIENT_TIMEOUT = 2000; // milliseconds to wait for a reply
+const int CLIENT_WAKE = 20; // milliseconds for the clock to leave power-down
+
+struct ClientFrameStruct
+{
+    ClientFrameStruct()
+    : type(0)
+    , length(0)
+    {
+        // empty
+    }
+
+    uint8_t type;
+    uint8_t length;
+    uint8_t payload[PROTOCOL_PAYLOAD];
+};
+
+static const char* const field_name[getValue(ProtocolField::COUNT)] =
+{
+    [getValue(ProtocolField::BRIGHTNESS)]       = "brightness",
+    [getValue(ProtocolField::GAIN)]             = "gain",
+    [getValue(ProtocolField::OFFSET)]           = "offset",
+    [getValue(ProtocolField::TIME_FORMAT)]      = "time_format",
+    [getValue(ProtocolField::DATE_FORMAT)]      = "date_format",
+    [getValue(ProtocolField::TEMPERATURE_UNIT)] = "temperature_unit",
+    [getValue(ProtocolField::NOISE)]            = "noise",
+    [getValue(ProtocolField::BATTERY)]          = "battery",
+    [getValue(ProtocolField::EFFECT)]           = "effect",
+    [getValue(ProtocolField::MUSIC_TIMER)]      = "music_timer",
+    [getValue(ProtocolField::PHRASE)]           = "phrase",
+};
+
+static const char* const trace_name[getValue(TraceType::COUNT)] =
+{
+    [getValue(TraceType::EMPTY)]        = "empty",
+    [getValue(TraceType::RESET)]        = "reset",
+    [getValue(TraceType::ALARM)]        = "alarm",
+    [getValue(TraceType::DISMISS)]      = "dismiss",
+    [getValue(TraceType::BLANK)]        = "blank",
+    [getValue(TraceType::BRIGHTNESS)]   = "brightness",
+    [getValue(TraceType::CONFIG)]       = "config",
+    [getValue(TraceType::BATTERY)]      = "battery",
+};
+
+static const char* const task_name[getValue(SupervisorTask::COUNT) + 1] =
+{
+    [getValue(SupervisorTask::LOOP)]    = "loop",
+    [getValue(SupervisorTask::DISPLAY)] = "display",
+    [getValue(SupervisorTask::RTC)]     = "clock",
+    [getValue(SupervisorTask::MENU)]    = "menu",
+    [getValue(SupervisorTask::COUNT)]   = "none",
+};
+
+static const char* const error_name[] =
+{
+    [getValue(ProtocolError::TYPE)]     = "unknown request",
+    [getValue(ProtocolError::LENGTH)]   = "bad length",
+    [getValue(ProtocolError::FIELD)]    = "unknown field",
+    [getValue(ProtocolError::RANGE)]    = "value out of range",
+    [getValue(ProtocolError::BUS)]      = "clock not responding",
+};
+
+
+static void Usage(const char* name)
+{
+    fprintf(stderr,
+        "usage: %s DEVICE COMMAND [ARGUMENTS]\n"
+        "  ping                     report firmware version\n"
+        "  get FIELD                read a config field\n"
+        "  set FIELD VALUE          write a config field, phrase takes %u characters\n"
+        "  time hh:mm:ss|now        set the RTC time\n"
+        "  date yy-mm-dd|now        set the RTC date\n"
+        "  play SONG                play an inbuilt song\n"
+        "  stop                     stop playback\n"
+        "  telemetry SECONDS [N]    stream telemetry, print N reports, 0 stops the stream\n"
+        "  nmea [RATE] [SECONDS]    send $GPRMC and $GPZDA each second of UTC, RATE times faster\n"
+        "  sync [RATE] [SECONDS]    send the local time each second, RATE times faster\n"
+        "  discipline               report reference phase and oscillator drift\n"
+        "  trace [FILE]             print the event trace, saving the DS3232 SRAM to FILE\n"
+        "  decode                   print the event trace saved in DEVICE\n"
+        "fields:",
+        name, DISPLAY_COUNT);
+
+    for (uint8_t field = 0; field < getValue(ProtocolField::COUNT); field++)
+    {
+        fprintf(stderr, " %s", field_name[field]);
+    }
+
+    fprintf(stderr, "\n");
+}
+
+
+static int Open(const char* device)
+{
+    int fd = open(device, O_RDWR | O_NOCTTY);
+    termios attributes;
+
+    if ((fd < 0) || tcgetattr(fd, &attributes))
+    {
+        return -1;
+    }
+
+    cfmakeraw(&attributes);
+    cfsetspeed(&attributes, B38400);
+    tcsetattr(fd, TCSANOW, &attributes);
+    tcflush(fd, TCIFLUSH); // Discard telemetry sent before this request
+    return fd;
+}
+
+
+static bool Send(const int fd, const ProtocolType type, const uint8_t* payload, const uint8_t length)
+{
+    uint8_t frame[PROTOCOL_PAYLOAD + PROTOCOL_OVERHEAD];
+    uint8_t crc = PROTOCOL_CRC_INIT;
+
+    frame[0] = PROTOCOL_SYNC;
+    frame[1] = length;
+    frame[2] = getValue(type);
+    memcpy(&frame[3], payload, length);
+
+    for (uint8_t index = 1; index < (length + 3); index++)
+    {
+        crc = _crc8_ccitt_update(crc, frame[index]);
+    }
+
+    frame[length + 3] = crc;
+    return (write(fd, frame, (length + PROTOCOL_OVERHEAD)) == (length + PROTOCOL_OVERHEAD));
+}
+
+
+// Next valid frame - false after timeout milliseconds without one
+// Decoder state persists so a frame may span calls
+static bool Receive(const int fd, ClientFrameStruct& frame, const int timeout)
+{
+    static uint8_t buffer[PROTOCOL_PAYLOAD + 2]; // Length, type and payload
+    static uint8_t count = 0;
+    static uint8_t crc = PROTOCOL_CRC_INIT;
+    static bool sync = false;
+    pollfd descriptor = {fd, POLLIN, 0};
+
+    while (poll(&descriptor, 1, timeout) > 0)
+    {
+        uint8_t data;
+
+        if (read(fd, &data, 1) != 1)
+        {
+            return false;
+        }
+
+        if (!sync)
+        {
+            sync = (data == PROTOCOL_SYNC);
+            count = 0;
+            crc = PROTOCOL_CRC_INIT;
+        }
+        else if ((count < 2) || (count < (buffer[0] + 2)))
+        {
+            if ((count == 0) && (data > PROTOCOL_PAYLOAD))
+            {
+                sync = false;
+                continue;
+            }
+
+            buffer[count++] = data;
+            crc = _crc8_ccitt_update(crc, data);
+        }
+        else
+        {
+            sync = false;
+
+            if (data == crc)
+            {
+                frame.length = buffer[0];
+                frame.type = buffer[1];
+                memcpy(frame.payload, &buffer[2], frame.length);
+                return true;
+            }
+
+            fprintf(stderr, "frame with bad CRC discarded\n");
+        }
+    }
+
+    return false;
+}
+
+
+static void PrintTelemetry(const ClientFrameStruct& frame)
+{
+    ProtocolTelemetryStruct telemetry;
+
+    if (frame.length != sizeof(telemetry))
+    {
+        fprintf(stderr, "telemetry of %u bytes ignored\n", frame.length);
+        return;
+    }
+
+    memcpy(&telemetry, frame.payload, sizeof(telemetry));
+    printf("uptime %u s, light %u, battery %u mV, temperature %.2f C, loops %u (max %u us), errors %u\n",
+           telemetry.uptime, telemetry.light, telemetry.battery, telemetry.temperature / 4.0,
+           telemetry.loops, telemetry.loop_max, telemetry.errors);
+    fflush(stdout);
+}
+
+
+static void PrintDiscipline(const ClientFrameStruct& frame)
+{
+    DisciplineStatusStruct status;
+
+    if (frame.length != sizeof(status))
+    {
+        fprintf(stderr, "discipline status of %u bytes ignored\n", frame.length);
+        return;
+    }
+
+    memcpy(&status, frame.payload, sizeof(status));
+    printf("phase %+.3f ms, offset %+.3f ms, drift %+.3f ppm, aging %d, samples %u, updates %u, steps %u%s\n",
+           status.phase / 1000.0, status.offset / 1000.0, status.drift / 1000.0, status.aging,
+           status.samples, status.updates, status.steps, status.sqw ? "" : ", no SQW");
+    fflush(stdout);
+}
+
+
+static void PrintTraceEntry(const TraceEntryStruct& entry)
+{
+    uint8_t type = (entry.tag >> 3);
+    uint16_t minute = (entry.time & 0x7FF);
+
+    printf("%2u %02u:%02u  %-10s  ", ((entry.time >> 11) + 1), (minute / 60), (minute % 60), trace_name[type]);
+
+    switch (static_cast<TraceType>(type))
+    {
+    case TraceType::RESET:
+    {
+        uint8_t mcusr = entry.data[0];
+        uint8_t task = std::min<uint8_t>(entry.data[1], getValue(SupervisorTask::COUNT));
+        printf("%s, stalled task %s\n", (mcusr & _BV(PORF)) ? "power-on" : (mcusr & _BV(WDRF)) ? "watchdog"
+               : (mcusr & _BV(BORF)) ? "brown-out" : (mcusr & _BV(EXTRF)) ? "external" : "jump to reset vector",
+               task_name[task]);
+        break;
+    }
+    case TraceType::ALARM:
+        if (entry.data[0] == TRACE_TIMER)
+        {
+            printf("timer, song %u\n", entry.data[1]);
+        }
+        else
+        {
+            printf("alarm %u, song %u\n", (entry.data[0] + 1), entry.data[1]);
+        }
+        break;
+    case TraceType::DISMISS:
+        printf("after %u s, %s\n", entry.data[0], entry.data[1] ? "by input" : "timed out");
+        break;
+    case TraceType::BLANK:
+        printf("%s\n", entry.data[0] ? "display off" : "display on");
+        break;
+    case TraceType::BRIGHTNESS:
+        printf("level %u from %u (0 is auto)\n", entry.data[0], entry.data[1]);
+        break;
+    case TraceType::CONFIG:
+        printf("saved %u bytes, version %u\n", entry.data[0], entry.data[1]);
+        break;
+    case TraceType::BATTERY:
+        printf("low at %u mV\n", (entry.data[0] | (entry.data[1] << 8)));
+        break;
+    default:
+        printf("%02X %02X\n", entry.data[0], entry.data[1]);
+        break;
+    }
+}
+
+
+// Oldest to newest from a copy of the DS3232 SRAM
+static bool PrintTrace(const uint8_t* sram)
+{
+    TraceEntryStruct ring[TRACE_ENTRIES];
+    uint8_t newest = TRACE_ENTRIES;
+
+    if (sram[0] != TRACE_MAGIC)
+    {
+        fprintf(stderr, "trace not formatted\n");
+        return false;
+    }
+
+    memcpy(ring, &sram[1], sizeof(ring));
+
+    for (uint8_t index = 0; index < TRACE_ENTRIES; index++)
+    {
+        if (TraceIsEntry(ring[index]) && !TraceFollows(ring[index], ring[(index + 1) % TRACE_ENTRIES]))
+        {
+            newest = index;
+            break;
+        }
+    }
+
+    for (uint8_t count = 1; (newest < TRACE_ENTRIES) && (count <= TRACE_ENTRIES); count++)
+    {
+        const TraceEntryStruct& entry = ring[(newest + count) % TRACE_ENTRIES];
+
+        if (TraceIsEntry(entry))
+        {
+            PrintTraceEntry(entry);
+        }
+    }
+
+    return true;
+}
+
+
+// Unsolicited frames - replies to requests without a waiting caller are dropped
+static void PrintFrame(const ClientFrameStruct& frame)
+{
+    if (frame.type == getValue(ProtocolType::TELEMETRY))
+    {
+        PrintTelemetry(frame);
+    }
+    else if (frame.type == getValue(ProtocolType::DISCIPLINE))
+    {
+        PrintDiscipline(frame);
+    }
+}
+
+
+// A blank clock in power-down loses the byte that wakes it, then stays awake for UART_IDLE_TIMEOUT
+static bool Wake(const int fd)
+{
+    const uint8_t wake = 0; // Neither PROTOCOL_SYNC nor '$', so both parsers skip it
+    bool result = (write(fd, &wake, 1) == 1);
+    usleep(CLIENT_WAKE * 1000);
+    return result;
+}
+
+
+// Send a request and wait for its reply - telemetry received meanwhile is printed
+static bool Request(const int fd, const ProtocolType type, const uint8_t* payload, const uint8_t length,
+                    ClientFrameStruct& reply)
+{
+    if (!Send(fd, type, payload, length))
+    {
+        fprintf(stderr, "write failed\n");
+        return false;
+    }
+
+    while (Receive(fd, reply, CLIENT_TIMEOUT))
+    {
+        if (reply.type == (getValue(type) | getValue(ProtocolType::REPLY)))
+        {
+            return true;
+        }
+
+        if ((reply.type == getValue(ProtocolType::NAK)) && (reply.length == 2) && (reply.payload[0] == getValue(type)))
+        {
+            uint8_t error = reply.payload[1];
+            fprintf(stderr, "rejected: %s\n", (error < (sizeof(error_name) / sizeof(error_name[0])))
+                                               ? error_name[error] : "unknown error");
+            return false;
+        }
+
+        PrintFrame(reply);
+    }
+
+    fprintf(stderr, "no reply\n");
+    return false;
+}
+
+
+static int FindField(const char* name)
+{
+    for (uint8_t field = 0; field < getValue(ProtocolField::COUNT); field++)
+    {
+        if (!strcmp(name, field_name[field]))
+        {
+            return field;
+        }
+    }
+
+    return -1;
+}
+
+
+// Three numbers separated by any single character, or the local clock
+static bool ParseTriple(const char* s, const bool time, uint8_t* value)
+{
+    unsigned parsed[3];
+
+    if (!strcmp(s, "now"))
+    {
+        time_t now = ::time(nullptr);
+        tm local;
+        localtime_r(&now, &local);
+        value[0] = time ? local.tm_hour : (local.tm_year % 100);
+        value[1] = time ? local.tm_min : (local.tm_mon + 1);
+        value[2] = time ? local.tm_sec : local.tm_mday;
+        return true;
+    }
+
+    if (sscanf(s, "%u%*c%u%*c%u", &parsed[0], &parsed[1], &parsed[2]) != 3)
+    {
+        return false;
+    }
+
+    for (uint8_t index = 0; index < 3; index++)
+    {
+        value[index] = parsed[index];
+    }
+
+    return true;
+}
+
+
+static uint64_t Now(void)
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((now.tv_sec * 1000000000ULL) + now.tv_nsec);
+}
+
+
+// Sleep until a CLOCK_MONOTONIC deadline in nanoseconds, printing frames received meanwhile
+// The last millisecond is spent spinning - wake-up latency is multiplied by the rate
+static void WaitUntil(const int fd, const uint64_t deadline)
+{
+    const uint64_t spin = 200000;
+    pollfd descriptor = {fd, POLLIN, 0};
+    ClientFrameStruct frame;
+
+    for (uint64_t now = Now(); now < deadline; now = Now())
+    {
+        uint64_t remaining = ((deadline - now) > spin) ? (deadline - now - spin) : 0;
+        timespec timeout = {(time_t)(remaining / 1000000000), (long)(remaining % 1000000000)};
+
+        if (ppoll(&descriptor, 1, &timeout, nullptr) > 0)
+        {
+            while (Receive(fd, frame, 0))
+            {
+                PrintFrame(frame);
+            }
+        }
+    }
+}
+
+
+static bool SendNmea(const int fd, const char* body)
+{
+    char sentence[DISCIPLINE_NMEA_LENGTH + 1];
+    uint8_t sum = 0;
+
+    for (const char* c = body; *c; c++)
+    {
+        sum ^= *c;
+    }
+
+    int length = snprintf(sentence, sizeof(sentence), "$%s*%02X\r\n", body, sum);
+    return (write(fd, sentence, length) == length);
+}
+
+
+// Reference seconds at rate times real time, starting at the next whole second
+// Sentences leave at the second they report, as a receiver would after its PPS edge
+static bool Reference(const int fd, const bool nmea, const double rate, const int seconds)
+{
+    time_t start = (::time(nullptr) + 1);
+    uint64_t begin = Now();
+
+    for (int second = 0; (seconds < 0) || (second < seconds); second++)
+    {
+        time_t reference = (start + second);
+        tm utc;
+        char body[DISCIPLINE_NMEA_LENGTH];
+        gmtime_r(&reference, &utc);
+
+        if (nmea)
+        {
+            WaitUntil(fd, (begin + (uint64_t)((second * 1e9) / rate)));
+            snprintf(body, sizeof(body), "GPRMC,%02d%02d%02d.00,A,4807.038,N,01131.000,E,0.0,0.0,%02d%02d%02d,,,A",
+                     utc.tm_hour, utc.tm_min, utc.tm_sec, utc.tm_mday, (utc.tm_mon + 1), (utc.tm_year % 100));
+
+            if (!SendNmea(fd, body))
+            {
+                return false;
+            }
+
+            snprintf(body, sizeof(body), "GPZDA,%02d%02d%02d.00,%02d,%02d,%04d,00,00",
+                     utc.tm_hour, utc.tm_min, utc.tm_sec, utc.tm_mday, (utc.tm_mon + 1), (utc.tm_year + 1900));
+
+            if (!SendNmea(fd, body))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            // Half a second in, so the milliseconds are exercised
+            tm local;
+            localtime_r(&reference, &local);
+            uint8_t payload[] = {(uint8_t)local.tm_hour, (uint8_t)local.tm_min, (uint8_t)local.tm_sec, (500 & 0xFF), (500 >> 8)};
+            WaitUntil(fd, (begin + (uint64_t)(((second + 0.5) * 1e9) / rate)));
+
+            if (!Send(fd, ProtocolType::TIME_SYNC, payload, sizeof(payload)))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    const char* command = argv[2];
+    const char* argument = (argc > 3) ? argv[3] : nullptr;
+    uint8_t payload[PROTOCOL_PAYLOAD];
+    uint8_t sram[TRACE_SRAM_BYTES];
+    ClientFrameStruct reply;
+
+    if (!strcmp(command, "decode"))
+    {
+        FILE* file = fopen(argv[1], "rb");
+        bool result = (file && (fread(sram, 1, sizeof(sram), file) == sizeof(sram)));
+
+        if (file)
+        {
+            fclose(file);
+        }
+
+        if (!result)
+        {
+            fprintf(stderr, "unable to read %u bytes from %s\n", TRACE_SRAM_BYTES, argv[1]);
+            return 1;
+        }
+
+        return PrintTrace(sram) ? 0 : 1;
+    }
+
+    int fd = Open(argv[1]);
+
+    if (fd < 0)
+    {
+        fprintf(stderr, "unable to open %s\n", argv[1]);
+        return 1;
+    }
+
+    if (!Wake(fd))
+    {
+        fprintf(stderr, "write failed\n");
+        return 1;
+    }
+
+    if (!strcmp(command, "ping"))
+    {
+        if (!Request(fd, ProtocolType::PING, nullptr, 0, reply))
+        {
+            return 1;
+        }
+
+        printf("version %u\n", reply.payload[0]);
+    }
+    else if (!strcmp(command, "get") && argument && (FindField(argument) >= 0))
+    {
+        payload[0] = FindField(argument);
+
+        if (!Request(fd, ProtocolType::CONFIG_READ, payload, 1, reply))
+        {
+            return 1;
+        }
+
+        if (payload[0] == getValue(ProtocolField::PHRASE))
+        {
+            printf("%s \"%.*s\"\n", argument, (reply.length - 1), &reply.payload[1]);
+        }
+        else
+        {
+            printf("%s %u\n", argument, reply.payload[1]);
+        }
+    }
+    else if (!strcmp(command, "set") && argument && (FindField(argument) >= 0) && (argc > 4))
+    {
+        uint8_t length = 1;
+        payload[0] = FindField(argument);
+
+        if (payload[0] == getValue(ProtocolField::PHRASE))
+        {
+            // Padded with spaces to the tube count
+            memset(&payload[1], ' ', DISPLAY_COUNT);
+            memcpy(&payload[1], argv[4], std::min<size_t>(strlen(argv[4]), DISPLAY_COUNT));
+            length += DISPLAY_COUNT;
+        }
+        else
+        {
+            payload[length++] = atoi(argv[4]);
+        }
+
+        if (!Request(fd, ProtocolType::CONFIG_WRITE, payload, length, reply))
+        {
+            return 1;
+        }
+    }
+    else if ((!strcmp(command, "time") || !strcmp(command, "date")) && argument
+             && ParseTriple(argument, !strcmp(command, "time"), payload))
+    {
+        ProtocolType type = !strcmp(command, "time") ? ProtocolType::TIME_SET : ProtocolType::DATE_SET;
+
+        if (!Request(fd, type, payload, 3, reply))
+        {
+            return 1;
+        }
+    }
+    else if (!strcmp(command, "play") && argument)
+    {
+        payload[0] = atoi(argument);
+
+        if (!Request(fd, ProtocolType::PLAY, payload, 1, reply))
+        {
+            return 1;
+        }
+    }
+    else if (!strcmp(command, "stop"))
+    {
+        if (!Request(fd, ProtocolType::STOP, nullptr, 0, reply))
+        {
+            return 1;
+        }
+    }
+    else if (!strcmp(command, "telemetry") && argument)
+    {
+        int reports = (argc > 4) ? atoi(argv[4]) : -1; // Negative streams until interrupted
+        payload[0] = atoi(argument);
+
+        if (!Request(fd, ProtocolType::TELEMETRY_RATE, payload, 1, reply))
+        {
+            return 1;
+        }
+
+        while (payload[0] && reports && Receive(fd, reply, (payload[0] * 1000) + CLIENT_TIMEOUT))
+        {
+            if (reply.type == getValue(ProtocolType::TELEMETRY))
+            {
+                PrintTelemetry(reply);
+                reports -= (reports > 0);
+            }
+        }
+    }
+    else if (!strcmp(command, "nmea") || !strcmp(command, "sync"))
+    {
+        double rate = argument ? atof(argument) : 1.0;
+        int seconds = (argc > 4) ? atoi(argv[4]) : -1; // Negative runs until interrupted
+
+        if (!(rate > 0) || !Reference(fd, !strcmp(command, "nmea"), rate, seconds))
+        {
+            fprintf(stderr, "reference stopped\n");
+            return 1;
+        }
+    }
+    else if (!strcmp(command, "discipline"))
+    {
+        if (!Request(fd, ProtocolType::DISCIPLINE_READ, nullptr, 0, reply))
+        {
+            return 1;
+        }
+
+        PrintDiscipline(reply);
+    }
+    else if (!strcmp(command, "trace"))
+    {
+        for (uint8_t offset = 0; offset < TRACE_SRAM_BYTES; offset += payload[1])
+        {
+            payload[0] = offset;
+            payload[1] = std::min<uint8_t>((PROTOCOL_PAYLOAD - 1), (TRACE_SRAM_BYTES - offset));
+
+            if (!Request(fd, ProtocolType::TRACE_READ, payload, 2, reply))
+            {
+                return 1;
+            }
+
+            memcpy(&sram[offset], &reply.payload[1], payload[1]);
+        }
+
+        if (argument)
+        {
+            FILE* file = fopen(argument, "wb");
+
+            if (!file || (fwrite(sram, 1, sizeof(sram), file) != sizeof(sram)) || fclose(file))
+            {
+                fprintf(stderr, "unable to write %s\n", argument);
+                return 1;
+            }
+        }
+
+        if (!PrintTrace(sram))
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        Usage(argv[0]);
+        return 1;
+    }
+
+    close(fd);
+    return 0;
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        eeprom.h
+ * @summary     Host shim for AVR EEPROM access
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _HOST_AVR_EEPROM_H
+#define _HOST_AVR_EEPROM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define E2END 0x3FF
+
+bool eeprom_is_ready(void);
+uint8_t eeprom_read_byte(const uint8_t* address);
+void eeprom_write_byte(uint8_t* address, const uint8_t value);
+void eeprom_update_byte(uint8_t* address, const uint8_t value);
+void eeprom_read_block(void* destination, const void* source, size_t size);
+void eeprom_update_block(const void* source, void* destination, size_t size);
+
+#endif
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        io.h
+ * @summary     Host shim for AVR I/O registers
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _HOST_AVR_IO_H
+#define _HOST_AVR_IO_H
+
+#include <stdint.h>
+
+#define _BV(bit) (1 << (bit))
+
+// Register whose reads and writes are observed by a peripheral model
+class HostRegister
+{
+    public:
+
+    typedef uint8_t (*ReadHook)(const uint8_t value);
+    typedef void (*WriteHook)(const uint8_t previous, const uint8_t value);
+
+    explicit HostRegister(const ReadHook read = nullptr, const WriteHook write = nullptr)
+    : m_read(read)
+    , m_write(write)
+    , m_value(0)
+    {
+        // empty
+    }
+
+    operator uint8_t() const { return m_read ? m_read(m_value) : m_value; }
+    HostRegister& operator=(const uint8_t value) { Write(value); return *this; }
+    HostRegister& operator|=(const uint8_t mask) { Write(*this | mask); return *this; }
+    HostRegister& operator&=(const uint8_t mask) { Write(*this & mask); return *this; }
+    HostRegister& operator^=(const uint8_t mask) { Write(*this ^ mask); return *this; }
+
+    private:
+
+    void Write(const uint8_t value)
+    {
+        uint8_t previous = m_value;
+        m_value = value;
+
+        if (m_write)
+        {
+            m_write(previous, value);
+        }
+    }
+
+    const ReadHook m_read;
+    const WriteHook m_write;
+    uint8_t m_value;
+};
+
+extern HostRegister PORTB;
+extern HostRegister PORTC;
+extern HostRegister PORTD;
+
+extern volatile uint8_t DDRB, DDRC, DDRD;
+extern volatile uint8_t PINB, PINC, PIND;
+extern volatile uint8_t GPIOR0, GPIOR1, GPIOR2;
+// Reset flags and watchdog
+extern volatile uint8_t MCUSR, WDTCSR;
+
+// Timer0
+extern volatile uint8_t TCCR0A, TCCR0B, TCNT0, OCR0A, OCR0B, TIMSK0, TIFR0;
+// Timer2
+extern volatile uint8_t TCCR2A, TCCR2B, TCNT2, OCR2A, OCR2B, TIMSK2, TIFR2;
+
+// External and pin change interrupts
+extern volatile uint8_t EICRA, EIMSK, EIFR, PCICR, PCIFR, PCMSK0, PCMSK1, PCMSK2;
+// Two-wire interface
+extern volatile uint8_t TWBR, TWSR, TWAR, TWDR, TWAMR;
+extern HostRegister TWCR;
+// EEPROM
+extern volatile uint8_t EEDR;
+extern volatile uint16_t EEAR;
+extern HostRegister EECR;
+// Analog to digital converter
+extern volatile uint8_t ADMUX, ADCSRA, ADCSRB, DIDR0;
+extern volatile uint16_t ADC;
+// USART0
+extern HostRegister UCSR0A, UCSR0B, UDR0;
+extern volatile uint8_t UCSR0C;
+extern volatile uint16_t UBRR0;
+
+#define PORF    0
+#define EXTRF   1
+#define BORF    2
+#define WDRF    3
+#define WDE     3
+#define WDIE    6
+#define OCIE0A  1
+#define OCIE2A  1
+#define WGM21   1
+#define CS20    0
+#define CS21    1
+#define CS22    2
+#define INTF0   0
+#define INTF1   1
+#define PCIE0   0
+#define PCIE1   1
+#define PCIE2   2
+#define PCINT8  0
+#define PCINT9  1
+#define PCINT10 2
+#define PCINT11 3
+#define PCINT16 0
+#define PCIF2   2
+#define TWIE    0
+#define TWEN    2
+#define TWWC    3
+#define TWSTO   4
+#define TWSTA   5
+#define TWEA    6
+#define TWINT   7
+#define EERE    0
+#define EEPE    1
+#define EEMPE   2
+#define EERIE   3
+#define EEPM0   4
+#define EEPM1   5
+#define MUX0    0
+#define REFS0   6
+#define REFS1   7
+#define ADPS0   0
+#define ADPS1   1
+#define ADPS2   2
+#define ADIE    3
+#define ADIF    4
+#define ADATE   5
+#define ADSC    6
+#define ADEN    7
+#define ADTS0   0
+#define ADTS1   1
+#define ADTS2   2
+#define ADC0D   0
+#define ADC1D   1
+#define ADC2D   2
+#define ADC3D   3
+#define MPCM0   0
+#define U2X0    1
+#define UPE0    2
+#define DOR0    3
+#define FE0     4
+#define UDRE0   5
+#define TXC0    6
+#define RXC0    7
+#define TXEN0   3
+#define RXEN0   4
+#define UDRIE0  5
+#define TXCIE0  6
+#define RXCIE0  7
+#define UCSZ00  1
+#define UCSZ01  2
+
+#endif
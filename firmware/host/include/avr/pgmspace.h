@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        pgmspace.h
+ * @summary     Host shim for AVR program memory access
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _HOST_AVR_PGMSPACE_H
+#define _HOST_AVR_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+// Flash and RAM share one address space on the host
+#define PROGMEM
+#define PGM_P                       const char*
+#define PSTR(s)                     (s)
+// Typed as avr-libc returns them - pointer tables use pgm_read_ptr
+#define pgm_read_byte(address)      (*(const uint8_t*)(address))
+#define pgm_read_byte_near(address) (*(const uint8_t*)(address))
+#define pgm_read_word(address)      (*(const uint16_t*)(address))
+#define pgm_read_word_near(address) (*(const uint16_t*)(address))
+#define pgm_read_dword(address)     (*(const uint32_t*)(address))
+#define pgm_read_ptr(address)       (*(void* const*)(address))
+#define memcpy_P                    memcpy
+#define strlen_P                    strlen
+#define strcpy_P                    strcpy
+#define strncpy_P                   strncpy
+#define snprintf_P                  snprintf
+
+#endif
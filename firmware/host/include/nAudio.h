@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        nAudio.h
+ * @summary     Host shim for the nAudio library
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _HOST_NAUDIO_H
+#define _HOST_NAUDIO_H
+
+#include <Arduino.h>
+
+// Stream tokens - values only need to be distinct on the host
+enum AudioToken : uint8_t
+{
+    NA3 = 0x01,
+    NA4 = 0x02,
+    NA5 = 0x03,
+    NA6 = 0x04,
+    NAS3 = 0x05,
+    NAS4 = 0x06,
+    NAS5 = 0x07,
+    NAS6 = 0x08,
+    NB3 = 0x09,
+    NB4 = 0x0A,
+    NB5 = 0x0B,
+    NB6 = 0x0C,
+    NC3 = 0x0D,
+    NC4 = 0x0E,
+    NC5 = 0x0F,
+    NC6 = 0x10,
+    NC7 = 0x11,
+    NC8 = 0x12,
+    NCS4 = 0x13,
+    NCS5 = 0x14,
+    NCS6 = 0x15,
+    NCS7 = 0x16,
+    ND3 = 0x17,
+    ND4 = 0x18,
+    ND5 = 0x19,
+    ND6 = 0x1A,
+    ND7 = 0x1B,
+    NDS3 = 0x1C,
+    NDS4 = 0x1D,
+    NDS5 = 0x1E,
+    NDS6 = 0x1F,
+    NE3 = 0x20,
+    NE4 = 0x21,
+    NE5 = 0x22,
+    NE6 = 0x23,
+    NF3 = 0x24,
+    NF4 = 0x25,
+    NF5 = 0x26,
+    NF6 = 0x27,
+    NFS3 = 0x28,
+    NFS4 = 0x29,
+    NFS5 = 0x2A,
+    NFS6 = 0x2B,
+    NG3 = 0x2C,
+    NG4 = 0x2D,
+    NG5 = 0x2E,
+    NG6 = 0x2F,
+    NG7 = 0x30,
+    NGS3 = 0x31,
+    NGS4 = 0x32,
+    NGS5 = 0x33,
+    NGS6 = 0x34,
+    NRS = 0x35,
+    NS0 = 0x36,
+    NS1 = 0x37,
+    NS2 = 0x38,
+    NS3 = 0x39,
+    NS4 = 0x3A,
+    NS5 = 0x3B,
+    NS6 = 0x3C,
+    NS7 = 0x3D,
+    DBLIP = 0xD0,
+    DDE = 0xD1,
+    DDH = 0xD2,
+    DDQ = 0xD3,
+    DE = 0xD4,
+    DH = 0xD5,
+    DQ = 0xD6,
+    DS = 0xD7,
+    DTE = 0xD8,
+    DTQ = 0xD9,
+    DW = 0xDA,
+    END = 0xFF,
+};
+
+class CAudio
+{
+    public:
+
+    enum class Functions : uint8_t
+    {
+        MemStream,
+        PGMStream,
+    };
+
+    CAudio(const uint8_t pin_a, const uint8_t pin_b, const uint8_t pin_c);
+
+    void Play(const Functions function, const uint8_t* a, const uint8_t* b, const uint8_t* c);
+    void Stop(void);
+    bool IsActive(void) const;
+
+    private:
+
+    unsigned long m_end;
+};
+
+#endif
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        nCoder.h
+ * @summary     Host shim for the nCoder library
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _HOST_NCODER_H
+#define _HOST_NCODER_H
+
+#include <Arduino.h>
+
+class CNcoder
+{
+    public:
+
+    enum class ButtonMode : uint8_t
+    {
+        NORMAL,
+        INVERT,
+    };
+
+    enum class RotationMode : uint8_t
+    {
+        NORMAL,
+        INVERT,
+    };
+
+    enum class Rotation : uint8_t
+    {
+        CW,
+        CCW,
+    };
+
+    enum class Button : uint8_t
+    {
+        UP,
+        DOWN,
+    };
+
+    typedef void (*Callback)(void);
+
+    CNcoder(const uint8_t button_pin, const ButtonMode button_mode, const RotationMode rotation_mode);
+
+    void SetCallback(Callback callback) { m_callback = callback; }
+    Rotation GetRotation(void) const { return m_rotation; }
+    void SetRotation(const Rotation rotation) { m_rotation = rotation; }
+    Button GetButtonState(void) const { return m_button; }
+    bool IsUpdateAvailable(void);
+
+    // Host input injection, normally driven by pin change interrupts
+    void HostRotate(const Rotation rotation);
+    void HostButton(const Button button);
+
+    private:
+
+    Callback m_callback;
+    Rotation m_rotation;
+    Button m_button;
+    uint8_t m_pending;
+};
+
+#endif
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        nDisplay.h
+ * @summary     Host shim for the nDisplay library
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _HOST_NDISPLAY_H
+#define _HOST_NDISPLAY_H
+
+#include <Arduino.h>
+#include <functional>
+
+typedef const __FlashStringHelper* const type_array;
+typedef uint8_t type_item;
+
+class CDisplay
+{
+    public:
+
+    static const uint8_t MAX_UNITS = 8;
+
+    enum class Brightness : uint8_t
+    {
+        AUTO,
+        L1,
+        L2,
+        L3,
+        L4,
+        L5,
+        L6,
+        L7,
+        L8,
+        MIN = L1,
+        MAX = L8,
+    };
+
+    enum class Direction : bool
+    {
+        LEFT,
+        RIGHT,
+    };
+
+    enum class Mode : bool
+    {
+        STATIC,
+        SCROLL,
+    };
+
+    enum class Event : uint8_t
+    {
+        NONE,
+        INCREMENT,
+        DECREMENT,
+        SELECTION,
+        TIMEOUT,
+    };
+
+    struct PromptSelectStruct
+    {
+        PromptSelectStruct()
+        : item_count(0)
+        , initial_selection(0)
+        , display_mode(Mode::STATIC)
+        , title(nullptr)
+        , item_array(nullptr)
+        {
+            // empty
+        }
+
+        uint8_t item_count;
+        uint8_t initial_selection;
+        Mode display_mode;
+        const __FlashStringHelper* title;
+        const type_array* item_array;
+    };
+
+    struct PromptValueStruct
+    {
+        PromptValueStruct()
+        : alphabetic(false)
+        , brightness_min(Brightness::MIN)
+        , item_count(0)
+        , item_position(nullptr)
+        , item_digit_count(nullptr)
+        , item_value(nullptr)
+        , item_lower_limit(nullptr)
+        , item_upper_limit(nullptr)
+        , initial_display(nullptr)
+        , title(nullptr)
+        {
+            // empty
+        }
+
+        bool alphabetic;
+        Brightness brightness_min;
+        uint8_t item_count;
+        const uint8_t* item_position;
+        const uint8_t* item_digit_count;
+        type_item* item_value;
+        const type_item* item_lower_limit;
+        const type_item* item_upper_limit;
+        const char* initial_display;
+        const __FlashStringHelper* title;
+    };
+
+    typedef bool (*CallbackInput)(void);
+    typedef std::function<bool(Event, uint8_t)> CallbackEvent;
+
+    explicit CDisplay(const uint8_t count);
+
+    void SetCallbackIsIncrement(CallbackInput callback);
+    void SetCallbackIsSelect(CallbackInput callback);
+    void SetCallbackIsUpdate(CallbackInput callback);
+
+    void SetDisplayValue(const char* s);
+    void SetDisplayValue(const __FlashStringHelper* s);
+    void SetDisplayValue(const uint32_t value);
+    void SetDisplayBrightness(const Brightness brightness);
+    void SetDisplayIndicator(const bool state);
+
+    void SetUnitValue(const uint8_t unit, const uint8_t value);
+    void SetUnitBrightness(const uint8_t unit, const Brightness brightness);
+    void SetUnitIndicator(const uint8_t unit, const bool state);
+
+    uint8_t GetUnitValue(const uint8_t unit) const { return m_value[unit]; }
+    Brightness GetUnitBrightness(const uint8_t unit) const { return m_brightness[unit]; }
+    bool GetUnitIndicator(const uint8_t unit) const { return m_indicator[unit]; }
+
+    void EffectScroll(const char* s, const Direction direction, const uint16_t delay_ms);
+    void EffectScroll(const __FlashStringHelper* s, const Direction direction, const uint16_t delay_ms);
+    void EffectSlotMachine(const uint8_t cycles);
+
+    int8_t PromptSelect(PromptSelectStruct& prompt, const uint32_t timeout, CallbackEvent callback = nullptr);
+    int8_t PromptValue(PromptValueStruct& prompt, const uint32_t timeout, CallbackEvent callback = nullptr);
+
+    private:
+
+    void ShowTitle(const __FlashStringHelper* title);
+    bool WaitRelease(void);
+
+    const uint8_t m_count;
+    uint8_t m_value[MAX_UNITS];
+    Brightness m_brightness[MAX_UNITS];
+    bool m_indicator[MAX_UNITS];
+    CallbackInput m_is_increment;
+    CallbackInput m_is_select;
+    CallbackInput m_is_update;
+};
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        crc16.h
+ * @summary     Host shim for avr-libc <util/crc16.h>
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _HOST_UTIL_CRC16_H
+#define _HOST_UTIL_CRC16_H
+
+#include <stdint.h>
+
+// CRC-16 polynomial x^16 + x^15 + x^2 + 1 (reflected 0xA001), as avr-libc _crc16_update()
+static inline uint16_t _crc16_update(uint16_t crc, const uint8_t data)
+{
+    crc ^= data;
+
+    for (uint8_t bit = 0; bit < 8; bit++)
+    {
+        crc = (crc & 0x01) ? ((crc >> 1) ^ 0xA001) : (crc >> 1);
+    }
+
+    return crc;
+}
+
+
+// CRC-8 polynomial x^8 + x^2 + x + 1, as avr-libc _crc8_ccitt_update()
+static inline uint8_t _crc8_ccitt_update(uint8_t crc, const uint8_t data)
+{
+    crc ^= data;
+
+    for (uint8_t bit = 0; bit < 8; bit++)
+    {
+        crc = (crc & 0x80) ? ((crc << 1) ^ 0x07) : (crc << 1);
+    }
+
+    return crc;
+}
+
+#endif
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026 nitacku
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * @file        twi.h
+ * @summary     Host shim for TWI status codes
+ * @version     1.0
+ * @author      nitacku
+ * @data        17 October 2026
+ */
+
+#ifndef _HOST_UTIL_TWI_H
+#define _HOST_UTIL_TWI_H
+
+#include <avr/io.h>
+
+#define TW_START            0x08
+#define TW_REP_START        0x10
+#define TW_MT_SLA_ACK       0x18
+#define TW_MT_SLA_NACK      0x20
+#define TW_MT_DATA_ACK      0x28
+#define TW_MT_DATA_NACK     0x30
+#define TW_MT_ARB_LOST      0x38
+#define TW_MR_SLA_ACK       0x40
+#define TW_MR_SLA_NACK      0x48
+#define TW_MR_DATA_ACK      0x50
+#define TW_MR_DATA_NACK     0x58
+#define TW_BUS_ERROR        0x00
+#define TW_STATUS_MASK      0xF8
+#define TW_STATUS           (TWSR & TW_STATUS_MASK)
+#define TW_READ             1
+#define TW_WRITE            0
+
+#endif